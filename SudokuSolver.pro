@@ -4,41 +4,19 @@
 #
 #-------------------------------------------------
 
-QT       += core gui
-
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
-
-TARGET = SudokuSolver
-TEMPLATE = app
-
-# The following define makes your compiler emit warnings if you use
-# any feature of Qt which has been marked as deprecated (the exact warnings
-# depend on your compiler). Please consult the documentation of the
-# deprecated API in order to know how to port your code away from it.
-DEFINES += QT_DEPRECATED_WARNINGS
-
-# You can also make your code fail to compile if you use deprecated APIs.
-# In order to do so, uncomment the following line.
-# You can also select to disable deprecated APIs only up to a certain version of Qt.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-CONFIG += c++11
-
-SOURCES += \
-        main.cpp \
-    sudokuboard.cpp \
-    sudoku.cpp
-
-HEADERS += \
-    sudokuboard.h \
-    sudoku.h
-
-FORMS += \
-        sudokusolver.ui
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
-
-DEFINES += PRO_PWD=\\\"$$_PRO_FILE_PWD_\\\"
+# core - headless solver library (QtCore only): generation, solving and validation
+# app  - Qt widgets application linking the core library
+# cli  - command-line batch solver linking the core library
+# bench - benchmark of the solver engines on the puzzle corpora in bench/corpora
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    core \
+    app \
+    cli \
+    bench
+
+app.depends = core
+cli.depends = core
+bench.depends = core
@@ -0,0 +1,429 @@
+#include "sudoku.h"
+#include "ui_sudokusolver.h"
+#include <QDebug>
+#include <QDateTime>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QtMath>
+#include "sudokubatch.h"
+
+Sudoku::Sudoku(QWidget *parent) :
+    QMainWindow(parent),
+    ui(new Ui::Sudoku),
+    solve_cancel_requested(false),
+    replay_pending(0)
+{
+    ui->setupUi(this);
+    ui->debugTextEdit->setFont(QFont("Consolas",10));
+    solve_progress_label = new QLabel(this);
+    ui->statusBar->addWidget(solve_progress_label);
+
+    // SIGNAL/SLOT CONNECTIONS
+    connect(ui->sudoku_ui, SIGNAL(clicked(QModelIndex)), this, SLOT(onItemClicked(QModelIndex)));
+    connect(ui->sudoku_ui, SIGNAL(entered(QModelIndex)), this, SLOT(onItemEntered(QModelIndex)));
+    connect(this,SIGNAL(debugPrint(QString,QColor,QColor)),this,SLOT(debugPrintSlot(QString,QColor,QColor)));
+    // emitted from the solving thread, delivered queued in the GUI thread
+    connect(this,SIGNAL(solveProgress(qint64,int,int)),this,SLOT(solveProgressSlot(qint64,int,int)));
+    connect(&solve_watcher,SIGNAL(finished()),this,SLOT(solveFinished()));
+    connect(&replay_timer,SIGNAL(timeout()),this,SLOT(replayTick()));
+    replay_timer.setInterval(REPLAY_TICK_MS);
+
+    // SOLVER CALLBACKS
+    installBoardHandlers();
+    createBoardUI();
+    generateBoardUI();
+
+}
+
+Sudoku::~Sudoku()
+{
+    // stop background solving before the board goes away
+    solve_cancel_requested = true;
+    solve_watcher.waitForFinished();
+    delete ui;
+}
+
+// function to connect the solver callbacks of the displayed board to the UI
+void Sudoku::installBoardHandlers()
+{
+    sudoku_board.setMessageHandler([this](const QString& message, MESSAGE_TYPE type){ boardMessage(message,type); });
+    sudoku_board.setProgressHandler(nullptr);
+}
+
+// function to enable or disable buttons while the board is being solved in the background
+void Sudoku::setSolvingUI(bool solving)
+{
+    ui->solveButton->setEnabled(!solving);
+    ui->regenarateBoardButton->setEnabled(!solving);
+    ui->cancelSolveButton->setEnabled(solving);
+    if(solving){
+        setReplayUI(false);
+    }
+}
+
+// function to enable or disable the replay controls, they cover the steps of the trace
+void Sudoku::setReplayUI(bool available)
+{
+    int steps = available ? replay_player.count() : 0;
+    ui->replayButton->setEnabled(available);
+    ui->replaySlider->setEnabled(available);
+    ui->replayStepSpinBox->setEnabled(available);
+    QSignalBlocker slider_blocker(ui->replaySlider);
+    QSignalBlocker spin_blocker(ui->replayStepSpinBox);
+    ui->replaySlider->setRange(0,steps);
+    ui->replaySlider->setValue(0);
+    ui->replayStepSpinBox->setRange(0,steps);
+    ui->replayStepSpinBox->setValue(0);
+}
+
+// function to pause the replay, the board keeps showing the current step
+void Sudoku::stopReplay()
+{
+    replay_timer.stop();
+    ui->replayButton->setText("Replay");
+}
+
+// function to show the board after the first 'step' steps of the trace
+// only the cells that differ from the shown step are repainted, the cell of the last step is highlighted
+void Sudoku::showReplayStep(int step)
+{
+    replay_player.seek(step);
+    for(int i=0; i<GUI_BOARD::CELLS; i++){
+        const SudokuTraceT<SUDOKU_GUI_BOX_SIZE>::TRACE_CELL& cell = replay_player.getCell(i);
+        board_model.setCell(i/GUI_BOARD::SIDE, i%GUI_BOARD::SIDE, cell.value, cell.candidates, cell.value != 0);
+    }
+    resetBoardColorUI();
+    QString step_info;
+    if(replay_player.getPosition() > 0){
+        quint32 last = replay_player.lastStep();
+        int row = traceIndex(last)/GUI_BOARD::SIDE;
+        int col = traceIndex(last)%GUI_BOARD::SIDE;
+        QString cell = " (" + QString::number(row+1) + "," + QString::number(col+1) + ") " + QString(charFromValue(traceValue(last)));
+        switch(traceEvent(last)){
+        case TRACE_PLACE:
+            highlightCell(row,col,Qt::magenta,Qt::white);
+            step_info = "placed" + cell;
+            break;
+        case TRACE_ELIMINATE:
+            highlightCell(row,col,Qt::darkYellow,Qt::white);
+            step_info = "eliminated" + cell;
+            break;
+        case TRACE_GUESS:
+            highlightCell(row,col,Qt::red,Qt::white);
+            step_info = "guessed" + cell;
+            break;
+        case TRACE_BACKTRACK:
+            step_info = "backtracked";
+            break;
+        }
+    }
+
+    QSignalBlocker slider_blocker(ui->replaySlider);
+    QSignalBlocker spin_blocker(ui->replayStepSpinBox);
+    ui->replaySlider->setValue(replay_player.getPosition());
+    ui->replayStepSpinBox->setValue(replay_player.getPosition());
+    solve_progress_label->setText("Step " + QString::number(replay_player.getPosition()) + "/" + QString::number(replay_player.count()) +
+                                  (step_info.isEmpty() ? QString() : ": " + step_info) +
+                                  (replay_trace.isTruncated() ? " (trace truncated)" : ""));
+}
+
+// function to create visible Sudoku board, the view shows the board model through the cell delegate
+void Sudoku::createBoardUI()
+{
+    // enable mouse tracking
+    ui->sudoku_ui->setMouseTracking(true);
+    ui->sudoku_ui->setSelectionMode(QAbstractItemView::NoSelection);
+    ui->sudoku_ui->setModel(&board_model);
+    ui->sudoku_ui->setItemDelegate(&cell_delegate);
+
+    // set up dimensions
+    for (int i=0;i< GUI_BOARD::SIDE;i++) {
+        ui->sudoku_ui->setRowHeight(i,SUDOKU_CELL_SIZE);
+        ui->sudoku_ui->setColumnWidth(i,SUDOKU_CELL_SIZE);
+    }
+    int extra_border = 0;
+    ui->sudoku_ui->setMinimumSize(GUI_BOARD::SIDE*SUDOKU_CELL_SIZE+extra_border,GUI_BOARD::SIDE*SUDOKU_CELL_SIZE+extra_border);
+    ui->sudoku_ui->setMaximumSize(GUI_BOARD::SIDE*SUDOKU_CELL_SIZE+extra_border,GUI_BOARD::SIDE*SUDOKU_CELL_SIZE+extra_border);
+    //ui->sudoku_ui->setStyleSheet("gridline-color: rgb(145,145,145);");
+}
+
+// function to generate new Sudoku board with a unique solution and reset colors
+void Sudoku::generateBoardUI()
+{
+    sudoku_board.generateUnique();
+    emit debugPrint("Difficulty: " + GUI_BOARD::formatRating(sudoku_board.rate()));
+    resetBoardColorUI();
+    redrawBoardUI();
+    qApp->processEvents();
+}
+
+// funtion to reset Sudoku board colors to defaults, only highlighted cells are repainted
+void Sudoku::resetBoardColorUI()
+{
+    board_model.clearHighlights();
+}
+
+// function to redraw Sudoku board values and candidate lists, only changed cells are repainted
+void Sudoku::redrawBoardUI()
+{
+    board_model.setBoard(sudoku_board);
+}
+
+// function to highlight cell neighbors, the previous highlight is cleared
+void Sudoku::highlightNeighbors(int row, int col, QRgb neighborBcolor, QRgb neighborFcolor, QRgb selItemBcolor, QRgb selItemFcolor)
+{
+    board_model.highlightNeighbors(row,col,neighborBcolor,neighborFcolor,selItemBcolor,selItemFcolor);
+}
+
+// function to highlight cell
+void Sudoku::highlightCell(int row, int col, QColor bcolor, QColor fcolor)
+{
+    board_model.setHighlight(row,col,bcolor.rgb(),fcolor.rgb());
+}
+
+// function to generate and solve 'num_tests' random boards on all cores
+// the batch runs in the background, the report is printed when it finishes
+void Sudoku::test(int num_tests)
+{
+    QString msg = "\n\n\n************** TESTING STARTED **************\nTime: " + QDateTime::currentDateTime().toString("dd.MM.yyyy,hh:mm:ss") + "\n";
+    emit debugPrint(msg);
+    ui->testButton->setEnabled(false);
+
+    QFutureWatcher<BATCH_REPORT>* watcher = new QFutureWatcher<BATCH_REPORT>(this);
+    connect(watcher, &QFutureWatcher<BATCH_REPORT>::finished, this, [this, watcher](){
+        emit debugPrint(SudokuBatch::formatReport(watcher->result()));
+        QString msg = "\n************** TESTING FINISHED **************\nTime: " + QDateTime::currentDateTime().toString("dd.MM.yyyy,hh:mm:ss") + "\n\n\n";
+        emit debugPrint(msg);
+        ui->testButton->setEnabled(true);
+        watcher->deleteLater();
+    });
+    SOLVER_ENGINE engine = sudoku_board.getEngine();
+    watcher->setFuture(QtConcurrent::run([num_tests, engine](){
+        // every worker thread generates and solves boards on its own board
+        SudokuBatchT<SUDOKU_GUI_BOX_SIZE> batch;
+        batch.setEngine(engine);
+        return batch.run(num_tests, [](qint64, GUI_BOARD& sudoku){
+            sudoku.generate();
+            return sudoku.solve();
+        });
+    }));
+}
+
+// SLOTS
+
+// function to respond on cell click
+void Sudoku::onItemClicked(const QModelIndex& index)
+{
+    Q_UNUSED(index);
+    // ...
+}
+
+// function to respond on cell enter
+// the highlight moves with the mouse, only the cells entering or leaving it are repainted
+void Sudoku::onItemEntered(const QModelIndex& index)
+{
+    highlightNeighbors(index.row(),
+                       index.column(),
+                       NEIGHBOR_BACKGROUND_COLOR,
+                       NEIGHBOR_FOREGROUND_COLOR,
+                       CELL_BACKGROUND_COLOR,
+                       CELL_FOREGROUND_COLOR);
+
+    // show coordinates of item
+    ui->currentItemCoord->setText("("+QString::number(index.row()+1)+","+QString::number(index.column()+1)+")");
+
+    // show candidates of item
+    QString cand_str = "n/a";
+    GUI_BOARD::cmask candidates = sudoku_board.getCandidates(index.row(),index.column());
+    if(candidates){
+        cand_str.clear();
+    }
+    for (GUI_BOARD::cmask m = candidates; m; m &= m-1){
+        cand_str += QString(charFromValue(firstCandidate(m)))+" ";
+    }
+    ui->candidates->setText(cand_str);
+}
+
+// function to respond when 'Regenerate board' button is clicked
+void Sudoku::on_regenarateBoardButton_clicked()
+{
+    stopReplay();
+    replay_player.setTrace(nullptr);
+    replay_trace.clear();
+    setReplayUI(false);
+    generateBoardUI();
+    ui->currentItemCoord->setText("(?,?)");
+    ui->candidates->setText("");
+    qApp->processEvents();
+}
+
+// function to respond when 'Unhighlight' button is clicked
+void Sudoku::on_unhighlightButton_clicked()
+{
+    resetBoardColorUI();
+    qApp->processEvents();
+}
+
+// function to respond when 'Solve' button is clicked
+// the board is solved on a worker thread, the displayed board is updated when solving finishes
+void Sudoku::on_solveButton_clicked()
+{
+    if(solve_watcher.isRunning()){
+        return;
+    }
+    stopReplay();
+    solve_cancel_requested = false;
+    setSolvingUI(true);
+    solve_progress_label->setText("Solving...");
+
+    // the worker thread talks to the UI only through queued signals
+    solving_board = sudoku_board;
+    solving_board.setMessageHandler([this](const QString& message, MESSAGE_TYPE type){ boardMessage(message,type); });
+    // recording costs time and up to 16 MB, it is only done when the steps are to be replayed
+    solving_board.setTraceEnabled(ui->recordStepsCheckBox->isChecked());
+    solving_board.setProgressHandler([this](const SOLVE_PROGRESS& progress){
+        emit solveProgress(progress.guesses, progress.depth, progress.filled);
+        return !solve_cancel_requested;
+    });
+    solve_watcher.setFuture(QtConcurrent::run([this](){ return solving_board.solve(); }));
+}
+
+// function to respond when another solver engine is selected, combo box items follow SOLVER_ENGINE order
+void Sudoku::on_engineComboBox_currentIndexChanged(int index)
+{
+    sudoku_board.setEngine(SOLVER_ENGINE(index));
+}
+
+// function to respond when 'Cancel' button is clicked
+void Sudoku::on_cancelSolveButton_clicked()
+{
+    solve_cancel_requested = true;
+}
+
+// function to respond when background solving finishes, the board is redrawn once
+void Sudoku::solveFinished()
+{
+    setSolvingUI(false);
+    emit debugPrint(GUI_BOARD::formatStats(solving_board.getStats()));
+    // the recorded steps can be replayed whatever the outcome, the dancing links and bitboard engines record none
+    replay_player.setTrace(nullptr);
+    solving_board.takeTrace(replay_trace);
+    replay_player.setTrace(replay_trace.isEmpty() ? nullptr : &replay_trace);
+    setReplayUI(!replay_trace.isEmpty());
+    if(solving_board.wasCancelled()){
+        solve_progress_label->setText("Solving cancelled after " + QString::number(solving_board.getGuessCount()) + " guesses");
+        return;
+    }
+    if(!solve_watcher.result()){
+        solve_progress_label->setText("No solution");
+        return;
+    }
+    solve_progress_label->setText("Solved with " + QString::number(solving_board.getGuessCount()) + " guesses");
+    sudoku_board = solving_board;
+    installBoardHandlers();
+    resetBoardColorUI();
+    redrawBoardUI();
+}
+
+// function to show progress of background solving
+void Sudoku::solveProgressSlot(qint64 guesses, int depth, int filled)
+{
+    if(!solve_watcher.isRunning()){
+        return;
+    }
+    solve_progress_label->setText("Solving... guesses: " + QString::number(guesses) +
+                                  ", search depth: " + QString::number(depth) +
+                                  ", cells filled: " + QString::number(filled) + "/" + QString::number(GUI_BOARD::CELLS));
+}
+
+// function to respond when 'Replay' button is clicked, starts or pauses the replay
+void Sudoku::on_replayButton_clicked()
+{
+    if(replay_timer.isActive()){
+        stopReplay();
+        return;
+    }
+    if(replay_player.getPosition() >= replay_player.count()){
+        showReplayStep(0);
+    }
+    replay_pending = 0;
+    replay_timer.start();
+    ui->replayButton->setText("Pause");
+}
+
+// function to respond when the replay slider is dragged
+void Sudoku::on_replaySlider_valueChanged(int step)
+{
+    showReplayStep(step);
+}
+
+// function to respond when a step is entered
+void Sudoku::on_replayStepSpinBox_valueChanged(int step)
+{
+    showReplayStep(step);
+}
+
+// function to advance the running replay, the speed slider goes from 1 to 100000 steps per second on a log scale
+void Sudoku::replayTick()
+{
+    replay_pending += qPow(10.0, ui->replaySpeedSlider->value()/20.0)*REPLAY_TICK_MS/1000.0;
+    int steps = int(replay_pending);
+    replay_pending -= steps;
+    if(steps == 0){
+        return;
+    }
+    showReplayStep(qMin(replay_player.getPosition()+steps, replay_player.count()));
+    if(replay_player.getPosition() >= replay_player.count()){
+        stopReplay();
+    }
+}
+
+// CUSTOM SLOTS
+
+// function to show solver message in the debug pane, colors depend on message type
+void Sudoku::boardMessage(const QString &message, MESSAGE_TYPE type)
+{
+    switch(type){
+    case MESSAGE_GENERATED:
+        emit debugPrint(message,QColor(GENERATED_MESSAGE_BACKGROUND_COLOR),Qt::black);
+        break;
+    case MESSAGE_SOLVED:
+        emit debugPrint(message,QColor(SOLVED_MESSAGE_BACKGROUND_COLOR),Qt::white);
+        break;
+    default:
+        emit debugPrint(message);
+        break;
+    }
+}
+
+void Sudoku::debugPrintSlot(QString message, QColor background, QColor foreground)
+{
+    QColor bsave = ui->debugTextEdit->textBackgroundColor();
+    QColor fsave = ui->debugTextEdit->textColor();
+    ui->debugTextEdit->setTextBackgroundColor(background);
+    ui->debugTextEdit->setTextColor(foreground);
+    ui->debugTextEdit->append(message);
+    ui->debugTextEdit->setTextBackgroundColor(bsave);
+    ui->debugTextEdit->setTextColor(fsave);
+    qApp->processEvents();
+}
+
+void Sudoku::on_testButton_clicked()
+{
+    test(ui->numtests->value());
+}
+
+void Sudoku::on_advanced_toggled(bool checked)
+{
+    if(checked){
+        ui->debugGroupBox->show();
+    }
+    else{
+        ui->debugGroupBox->hide();
+    }
+}
+
+void Sudoku::on_pushButton_clicked()
+{
+    ui->debugTextEdit->clear();
+}
@@ -0,0 +1,93 @@
+#ifndef SUDOKUSOLVER_H
+#define SUDOKUSOLVER_H
+
+#include <QMainWindow>
+#include <QModelIndex>
+#include <QFutureWatcher>
+#include <QLabel>
+#include <QTimer>
+#include <atomic>
+#include "sudokuboardmodel.h"
+#include "sudokucelldelegate.h"
+
+#define SELECTION_COLOR qRgb(0, 163, 204)
+
+#define NEIGHBOR_BACKGROUND_COLOR qRgb(0, 153, 204)
+#define NEIGHBOR_FOREGROUND_COLOR qRgb(255,255,255)
+#define CELL_BACKGROUND_COLOR qRgb(0,0,0)
+#define CELL_FOREGROUND_COLOR qRgb(255,255,255)
+
+// the replay advances the trace once per tick by the steps per second of the speed slider
+#define REPLAY_TICK_MS 16
+
+#define GENERATED_MESSAGE_BACKGROUND_COLOR qRgb(153, 235, 255)
+#define SOLVED_MESSAGE_BACKGROUND_COLOR qRgb(0, 143, 179)
+
+namespace Ui {
+class Sudoku;
+}
+
+class Sudoku : public QMainWindow
+{
+    Q_OBJECT
+
+public:
+    explicit Sudoku(QWidget *parent = nullptr);
+    ~Sudoku();
+
+private slots:
+    // SLOTS
+    void onItemClicked(const QModelIndex&);
+    void onItemEntered(const QModelIndex&);
+    void on_regenarateBoardButton_clicked();
+    void on_unhighlightButton_clicked();
+    void on_solveButton_clicked();
+    void on_cancelSolveButton_clicked();
+    void on_engineComboBox_currentIndexChanged(int index);
+    void solveFinished();
+    void solveProgressSlot(qint64 guesses, int depth, int filled);
+    void on_replayButton_clicked();
+    void on_replaySlider_valueChanged(int step);
+    void on_replayStepSpinBox_valueChanged(int step);
+    void replayTick();
+    // CUSTOM SLOTS
+    void debugPrintSlot(QString message, QColor background, QColor foreground);
+    void on_testButton_clicked();
+
+    void on_advanced_toggled(bool checked);
+
+    void on_pushButton_clicked();
+
+private:
+    Ui::Sudoku *ui;
+    GUI_BOARD sudoku_board;
+    GUI_BOARD solving_board; // copy of the board solved on a worker thread
+    SudokuBoardModel board_model;
+    SudokuCellDelegate cell_delegate;
+    SudokuTraceT<SUDOKU_GUI_BOX_SIZE> replay_trace; // steps of the last solve
+    SudokuTracePlayerT<SUDOKU_GUI_BOX_SIZE> replay_player;
+    QTimer replay_timer;
+    double replay_pending; // steps due at the next tick, fractions carry over
+    QFutureWatcher<bool> solve_watcher;
+    std::atomic<bool> solve_cancel_requested;
+    QLabel* solve_progress_label;
+    void installBoardHandlers();
+    void setSolvingUI(bool solving);
+    void setReplayUI(bool available);
+    void stopReplay();
+    void showReplayStep(int step);
+    void createBoardUI();
+    void resetBoardColorUI();
+    void generateBoardUI();
+    void redrawBoardUI();
+    void highlightNeighbors(int,int, QRgb, QRgb, QRgb, QRgb);
+    void highlightCell(int,int,QColor,QColor);
+    void test(int);
+    void boardMessage(const QString& message, MESSAGE_TYPE type);
+
+signals:
+    void debugPrint(QString message, QColor background = Qt::white, QColor foreground = Qt::black);
+    void solveProgress(qint64 guesses, int depth, int filled);
+};
+
+#endif // SUDOKUSOLVER_H
@@ -0,0 +1,166 @@
+#include "sudokuboardmodel.h"
+#include <QFont>
+
+SudokuBoardModel::SudokuBoardModel(QObject* parent) :
+    QAbstractTableModel(parent)
+{
+    for(int i=0; i<GUI_BOARD::CELLS; i++){
+        cells[i].value = 0;
+        cells[i].candidates = 0;
+        cells[i].revealed = false;
+        cells[i].background = 0;
+        cells[i].foreground = 0;
+        cells[i].bold = false;
+    }
+}
+
+int SudokuBoardModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : GUI_BOARD::SIDE;
+}
+
+int SudokuBoardModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : GUI_BOARD::SIDE;
+}
+
+// function to return the cell for the standard roles, the board delegate reads getCell() instead
+QVariant SudokuBoardModel::data(const QModelIndex& index, int role) const
+{
+    if(!index.isValid()){
+        return QVariant();
+    }
+    const CELL_VIEW& cell = getCell(index.row(), index.column());
+    switch(role){
+    case Qt::DisplayRole:
+        if(cell.revealed){
+            return QString(charFromValue(cell.value));
+        }
+        else{
+            QString str;
+            for(GUI_BOARD::cmask m = cell.candidates; m; m &= m-1){
+                str += QString(charFromValue(firstCandidate(m))) + " ";
+            }
+            return str;
+        }
+    case Qt::BackgroundRole:
+        return QColor(getBackground(index.row(), index.column()));
+    case Qt::ForegroundRole:
+        return QColor(getForeground(index.row(), index.column()));
+    case Qt::FontRole:
+        if(cell.revealed){
+            return cell.bold ? NORMAL_HIGHLIGHT_FONT : NORMAL_FONT;
+        }
+        return CANDIDATE_FONT;
+    case Qt::TextAlignmentRole:
+        return cell.revealed ? int(Qt::AlignCenter) : int(Qt::AlignTop | Qt::AlignLeft);
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags SudokuBoardModel::flags(const QModelIndex& index) const
+{
+    return index.isValid() ? Qt::ItemIsEnabled : Qt::NoItemFlags;
+}
+
+// function to return the background of the cell, the highlight or the box shading
+QRgb SudokuBoardModel::getBackground(int row, int col) const
+{
+    const CELL_VIEW& cell = getCell(row, col);
+    if(cell.background){
+        return cell.background;
+    }
+    int box_r = row/GUI_BOARD::BOX;
+    int box_c = col/GUI_BOARD::BOX;
+    return (box_r+box_c)%2 ? SECONDARY_COLOR : PRIMARY_COLOR;
+}
+
+// function to return the text color of the cell, the highlight or the value/candidate color
+QRgb SudokuBoardModel::getForeground(int row, int col) const
+{
+    const CELL_VIEW& cell = getCell(row, col);
+    if(cell.foreground){
+        return cell.foreground;
+    }
+    return cell.revealed ? CELL_TEXT_COLOR : CANDIDATE_TEXT_COLOR;
+}
+
+// function to take the values and candidates of the board, only the cells that differ are repainted
+void SudokuBoardModel::setBoard(const GUI_BOARD& board)
+{
+    const QVector<QVector<GUI_BOARD::CELL_INFO>>& b = board.getBoard();
+    for(int i=0; i<GUI_BOARD::SIDE; i++){
+        for(int j=0; j<GUI_BOARD::SIDE; j++){
+            setCell(i, j, b[i][j].value, b[i][j].candidates, b[i][j].revealed);
+        }
+    }
+}
+
+// function to change one cell, the cell is repainted only if it changed
+void SudokuBoardModel::setCell(int row, int col, val value, GUI_BOARD::cmask candidates, bool revealed)
+{
+    int index = row*GUI_BOARD::SIDE+col;
+    CELL_VIEW& cell = cells[index];
+    if(cell.value == value && cell.candidates == candidates && cell.revealed == revealed){
+        return;
+    }
+    cell.value = value;
+    cell.candidates = candidates;
+    cell.revealed = revealed;
+    cellChanged(index);
+}
+
+// function to highlight the cell until the highlights are cleared
+void SudokuBoardModel::setHighlight(int row, int col, QRgb background, QRgb foreground, bool bold)
+{
+    changeHighlight(row*GUI_BOARD::SIDE+col, background, foreground, bold);
+}
+
+// function to highlight the cell and its peers, every other highlight is cleared
+// cells that keep their highlight (e.g. the shared peers of two neighboring cells) are not repainted
+void SudokuBoardModel::highlightNeighbors(int row, int col, QRgb neighborBackground, QRgb neighborForeground, QRgb cellBackground, QRgb cellForeground)
+{
+    for(int i=0; i<GUI_BOARD::SIDE; i++){
+        for(int j=0; j<GUI_BOARD::SIDE; j++){
+            int index = i*GUI_BOARD::SIDE+j;
+            if(i == row && j == col){
+                changeHighlight(index, cellBackground, cellForeground, false);
+            }
+            else if(i == row || j == col || (i/GUI_BOARD::BOX == row/GUI_BOARD::BOX && j/GUI_BOARD::BOX == col/GUI_BOARD::BOX)){
+                changeHighlight(index, neighborBackground, neighborForeground, true);
+            }
+            else{
+                changeHighlight(index, 0, 0, false);
+            }
+        }
+    }
+}
+
+// function to return all cells to the default colors
+void SudokuBoardModel::clearHighlights()
+{
+    for(int i=0; i<GUI_BOARD::CELLS; i++){
+        changeHighlight(i, 0, 0, false);
+    }
+}
+
+// function to set the highlight of the cell, the cell is repainted only if it changed
+void SudokuBoardModel::changeHighlight(int index, QRgb background, QRgb foreground, bool bold)
+{
+    CELL_VIEW& cell = cells[index];
+    if(cell.background == background && cell.foreground == foreground && cell.bold == bold){
+        return;
+    }
+    cell.background = background;
+    cell.foreground = foreground;
+    cell.bold = bold;
+    cellChanged(index);
+}
+
+// function to invalidate one cell, a single index lets the view repaint only that cell's rectangle
+void SudokuBoardModel::cellChanged(int index)
+{
+    QModelIndex changed = createIndex(index/GUI_BOARD::SIDE, index%GUI_BOARD::SIDE);
+    emit dataChanged(changed, changed);
+}
@@ -0,0 +1,71 @@
+#ifndef SUDOKUBOARDMODEL_H
+#define SUDOKUBOARDMODEL_H
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include "sudokuboard.h"
+
+// box size of the board shown by the GUI: 3 for 9x9, 4 for 16x16, 5 for 25x25
+#ifndef SUDOKU_GUI_BOX_SIZE
+#define SUDOKU_GUI_BOX_SIZE SUDOKU_BOX_SIZE
+#endif
+typedef SudokuBoardT<SUDOKU_GUI_BOX_SIZE> GUI_BOARD;
+
+// 50 pixels for 9x9, larger boards get smaller cells
+#define SUDOKU_CELL_SIZE qMax(30, 450/GUI_BOARD::SIDE)
+
+#define PRIMARY_COLOR qRgb(230,230,230)
+#define SECONDARY_COLOR qRgb(255, 255, 255)
+
+#define NORMAL_FONT QFont("Tahoma",12)
+#define CANDIDATE_FONT QFont("Tahoma",8)
+#define NORMAL_HIGHLIGHT_FONT QFont("Tahoma",12,QFont::Bold)
+
+#define CANDIDATE_TEXT_COLOR qRgb(130,130,130)
+#define CELL_TEXT_COLOR qRgb(0,0,0)
+
+// table model of the displayed board, one item per cell
+// the model keeps a copy of what is on screen and reports only the cells whose value, candidates
+// or highlight changed, so the view repaints those cells instead of the whole board
+class SudokuBoardModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    // what is painted in one cell
+    typedef struct {
+        val value;
+        GUI_BOARD::cmask candidates;
+        bool revealed;
+        QRgb background;    // highlight colors, 0 when the cell is not highlighted
+        QRgb foreground;
+        bool bold;          // revealed value drawn in bold
+    } CELL_VIEW;
+
+    explicit SudokuBoardModel(QObject* parent = nullptr);
+
+    // QAbstractTableModel
+    int rowCount(const QModelIndex& parent = QModelIndex()) const;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+    Qt::ItemFlags flags(const QModelIndex& index) const;
+
+    // cell state for the delegate, no QVariant round trip
+    const CELL_VIEW& getCell(int row, int col) const { return cells[row*GUI_BOARD::SIDE+col]; }
+    QRgb getBackground(int row, int col) const;
+    QRgb getForeground(int row, int col) const;
+
+    // updates, each changed cell emits its own dataChanged()
+    void setBoard(const GUI_BOARD& board);
+    void setCell(int row, int col, val value, GUI_BOARD::cmask candidates, bool revealed);
+    void setHighlight(int row, int col, QRgb background, QRgb foreground, bool bold = false);
+    void highlightNeighbors(int row, int col, QRgb neighborBackground, QRgb neighborForeground, QRgb cellBackground, QRgb cellForeground);
+    void clearHighlights();
+
+private:
+    CELL_VIEW cells[GUI_BOARD::CELLS];
+    void changeHighlight(int index, QRgb background, QRgb foreground, bool bold);
+    void cellChanged(int index);
+};
+
+#endif // SUDOKUBOARDMODEL_H
@@ -0,0 +1,47 @@
+#include "sudokucelldelegate.h"
+#include <QPainter>
+
+SudokuCellDelegate::SudokuCellDelegate(QObject* parent) :
+    QStyledItemDelegate(parent),
+    value_font(NORMAL_FONT),
+    value_highlight_font(NORMAL_HIGHLIGHT_FONT),
+    candidate_font(CANDIDATE_FONT)
+{
+    for(int v=1; v<=GUI_BOARD::SIDE; v++){
+        value_text[v] = QString(charFromValue(val(v)));
+    }
+}
+
+// function to paint one cell straight from the model state
+void SudokuCellDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    const SudokuBoardModel* model = static_cast<const SudokuBoardModel*>(index.model());
+    const SudokuBoardModel::CELL_VIEW& cell = model->getCell(index.row(), index.column());
+    const QRect& rect = option.rect;
+
+    painter->save();
+    painter->fillRect(rect, QColor(model->getBackground(index.row(), index.column())));
+    painter->setPen(QColor(model->getForeground(index.row(), index.column())));
+    if(cell.revealed){
+        painter->setFont(cell.bold ? value_highlight_font : value_font);
+        painter->drawText(rect, Qt::AlignCenter, value_text[cell.value]);
+    }
+    else{
+        // candidate v is drawn in the grid place of v, so candidates do not move when others are removed
+        painter->setFont(candidate_font);
+        int w = rect.width()/GUI_BOARD::BOX;
+        int h = rect.height()/GUI_BOARD::BOX;
+        for(GUI_BOARD::cmask m = cell.candidates; m; m &= m-1){
+            val v = firstCandidate(m);
+            int place = v-1;
+            QRect sub(rect.x()+(place%GUI_BOARD::BOX)*w, rect.y()+(place/GUI_BOARD::BOX)*h, w, h);
+            painter->drawText(sub, Qt::AlignCenter, value_text[v]);
+        }
+    }
+    painter->restore();
+}
+
+QSize SudokuCellDelegate::sizeHint(const QStyleOptionViewItem&, const QModelIndex&) const
+{
+    return QSize(SUDOKU_CELL_SIZE, SUDOKU_CELL_SIZE);
+}
@@ -0,0 +1,26 @@
+#ifndef SUDOKUCELLDELEGATE_H
+#define SUDOKUCELLDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QFont>
+#include "sudokuboardmodel.h"
+
+// delegate painting the cells of SudokuBoardModel
+// a revealed cell shows its value, an unrevealed cell a BOX x BOX grid with every candidate at a fixed place;
+// fonts and value strings are prepared once, painting a cell allocates nothing
+class SudokuCellDelegate : public QStyledItemDelegate
+{
+public:
+    explicit SudokuCellDelegate(QObject* parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const;
+
+private:
+    QFont value_font;
+    QFont value_highlight_font;
+    QFont candidate_font;
+    QString value_text[GUI_BOARD::SIDE+1];
+};
+
+#endif // SUDOKUCELLDELEGATE_H
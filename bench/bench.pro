@@ -0,0 +1,25 @@
+#-------------------------------------------------
+#
+# Benchmark of the solver engines on fixed puzzle corpora
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = sudoku-bench
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+        main.cpp
+
+include(../core/sudokucore.pri)
+
+# peak memory of the process on Windows
+win32: LIBS += -lpsapi
+
+# the corpora are read from the source tree unless --corpus is given
+DEFINES += BENCH_CORPUS_DIR=\\\"$$clean_path($$_PRO_FILE_PWD_/corpora)\\\"
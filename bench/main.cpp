@@ -0,0 +1,266 @@
+#include "sudokuboard.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QDateTime>
+#include <algorithm>
+#include <cstdio>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// how often the solvers report progress, a solve running longer than the timeout is cancelled there
+#define BENCH_PROGRESS_INTERVAL_MS 10
+
+// result of one corpus solved by one engine, latencies in milliseconds
+typedef struct {
+    QString corpus;
+    QString engine;
+    qint64 puzzles;
+    qint64 solved;
+    qint64 timeouts;        // cancelled after the timeout
+    qint64 wrong;           // reported solved, but the solution is not valid for the puzzle
+    double total_seconds;
+    double puzzles_per_second;
+    double mean_ms;
+    double p50_ms;
+    double p99_ms;
+    double max_ms;
+    double guesses_per_puzzle;
+    qint64 peak_rss_kb;     // peak resident memory of the process so far
+} BENCH_RESULT;
+
+// engines measured by the benchmark, in SOLVER_ENGINE order
+static const char* const engine_names[] = {"deduction", "dlx", "bitboard"};
+
+// function to return the peak resident memory of the process in kilobytes
+static qint64 peakRssKb()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))){
+        return qint64(counters.PeakWorkingSetSize/1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(Q_OS_MACOS)
+    return qint64(usage.ru_maxrss/1024); // bytes on macOS
+#else
+    return qint64(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// function to read the puzzles of a corpus file, one puzzle per line, lines starting with '#' are comments
+static QVector<QByteArray> readCorpus(const QString& path)
+{
+    QVector<QByteArray> puzzles;
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly)){
+        return puzzles;
+    }
+    while(!file.atEnd()){
+        QByteArray line = file.readLine().trimmed();
+        if(line.size() < CELL_COUNT || line.startsWith('#')){
+            continue;
+        }
+        puzzles.push_back(line.left(CELL_COUNT));
+    }
+    return puzzles;
+}
+
+// function to return true if 'solution' is a solved board that keeps every clue of 'puzzle'
+static bool isSolutionOf(SudokuBoard& board, const char* solution, const QByteArray& puzzle)
+{
+    if(!board.isSolved()){
+        return false;
+    }
+    for(int i=0; i<CELL_COUNT; i++){
+        int clue = valueFromChar(puzzle[i]);
+        if(clue > 0 && valueFromChar(solution[i]) != clue){
+            return false;
+        }
+    }
+    return true;
+}
+
+// function to solve every puzzle of the corpus with the engine and measure it
+static BENCH_RESULT runCorpus(const QString& corpus, const QVector<QByteArray>& puzzles, SOLVER_ENGINE engine, int timeout_ms)
+{
+    BENCH_RESULT result = {};
+    result.corpus = corpus;
+    result.engine = engine_names[engine];
+    result.puzzles = puzzles.count();
+
+    SudokuBoard board;
+    board.setEngine(engine);
+    QElapsedTimer timer;
+    if(timeout_ms > 0){
+        board.setProgressHandler([&timer, timeout_ms](const SOLVE_PROGRESS&){
+            return timer.elapsed() < timeout_ms;
+        }, BENCH_PROGRESS_INTERVAL_MS);
+    }
+
+    QVector<qint64> latencies;
+    latencies.reserve(puzzles.count());
+    qint64 guesses = 0;
+    char solution[CELL_COUNT+1];
+    solution[CELL_COUNT] = '\0';
+    for(const QByteArray& puzzle : puzzles){
+        if(!board.loadString(puzzle.constData())){
+            result.wrong++;
+            continue;
+        }
+        timer.start();
+        bool ok = board.solve();
+        latencies.push_back(timer.nsecsElapsed());
+        guesses += board.getGuessCount();
+        if(board.wasCancelled()){
+            result.timeouts++;
+            continue;
+        }
+        board.writeString(solution);
+        if(ok && isSolutionOf(board, solution, puzzle)){
+            result.solved++;
+        }
+        else{
+            result.wrong++;
+        }
+    }
+
+    qint64 total_ns = 0;
+    for(qint64 ns : latencies){
+        total_ns += ns;
+    }
+    result.total_seconds = total_ns/1e9;
+    if(!latencies.isEmpty()){
+        std::sort(latencies.begin(), latencies.end());
+        int n = latencies.count();
+        result.puzzles_per_second = result.total_seconds > 0 ? n/result.total_seconds : 0;
+        result.mean_ms = total_ns/1e6/n;
+        result.p50_ms = latencies[n/2]/1e6;
+        result.p99_ms = latencies[qMin(n-1, n*99/100)]/1e6;
+        result.max_ms = latencies.last()/1e6;
+        result.guesses_per_puzzle = double(guesses)/n;
+    }
+    result.peak_rss_kb = peakRssKb();
+    return result;
+}
+
+// function to convert the result to JSON
+static QJsonObject toJson(const BENCH_RESULT& r)
+{
+    QJsonObject o;
+    o["corpus"] = r.corpus;
+    o["engine"] = r.engine;
+    o["puzzles"] = double(r.puzzles);
+    o["solved"] = double(r.solved);
+    o["timeouts"] = double(r.timeouts);
+    o["wrong"] = double(r.wrong);
+    o["total_seconds"] = r.total_seconds;
+    o["puzzles_per_second"] = r.puzzles_per_second;
+    o["mean_ms"] = r.mean_ms;
+    o["p50_ms"] = r.p50_ms;
+    o["p99_ms"] = r.p99_ms;
+    o["max_ms"] = r.max_ms;
+    o["guesses_per_puzzle"] = r.guesses_per_puzzle;
+    o["peak_rss_kb"] = double(r.peak_rss_kb);
+    return o;
+}
+
+// benchmark of the solver engines
+// every corpus (*.txt in the corpus directory) is solved by every selected engine on one thread,
+// a table is printed on stdout and with --json the results are also written as JSON
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("sudoku-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks the solver engines on the puzzle corpora.");
+    parser.addHelpOption();
+    QCommandLineOption engineOption(QStringList() << "e" << "engine", "Engine to measure: deduction, dlx, bitboard or all (default).", "engine", "all");
+    parser.addOption(engineOption);
+    QCommandLineOption corpusOption(QStringList() << "c" << "corpus", "Directory with the corpora, one puzzle per line in every *.txt file.", "dir", BENCH_CORPUS_DIR);
+    parser.addOption(corpusOption);
+    QCommandLineOption timeoutOption(QStringList() << "t" << "timeout", "Puzzles taking longer are cancelled and counted as timeouts, 0 is no limit.", "ms", "2000");
+    parser.addOption(timeoutOption);
+    QCommandLineOption jsonOption(QStringList() << "j" << "json", "Write the results as JSON to the file, '-' is standard output.", "file");
+    parser.addOption(jsonOption);
+    parser.process(a);
+
+    QVector<SOLVER_ENGINE> engines;
+    QString engine = parser.value(engineOption);
+    for(int e=0; e<3; e++){
+        if(engine == "all" || engine == engine_names[e]){
+            engines.push_back(SOLVER_ENGINE(e));
+        }
+    }
+    if(engines.isEmpty()){
+        fprintf(stderr, "unknown engine %s\n", qPrintable(engine));
+        return 1;
+    }
+
+    QDir dir(parser.value(corpusOption));
+    QFileInfoList files = dir.entryInfoList(QStringList() << "*.txt", QDir::Files, QDir::Name);
+    if(files.isEmpty()){
+        fprintf(stderr, "no corpora in %s\n", qPrintable(dir.path()));
+        return 1;
+    }
+    int timeout_ms = parser.value(timeoutOption).toInt();
+
+    bool json_to_stdout = parser.value(jsonOption) == "-";
+    FILE* table = json_to_stdout ? stderr : stdout;
+    fprintf(table, "%-12s %-10s %7s %7s %5s %5s %12s %10s %10s %10s %10s %10s %10s\n",
+            "corpus", "engine", "puzzles", "solved", "tout", "wrong", "puzzles/s", "mean ms", "p50 ms", "p99 ms", "max ms", "guesses", "rss kB");
+
+    QJsonArray results;
+    for(const QFileInfo& file : files){
+        QVector<QByteArray> puzzles = readCorpus(file.filePath());
+        for(SOLVER_ENGINE e : engines){
+            BENCH_RESULT r = runCorpus(file.completeBaseName(), puzzles, e, timeout_ms);
+            fprintf(table, "%-12s %-10s %7lld %7lld %5lld %5lld %12.1f %10.3f %10.3f %10.3f %10.3f %10.1f %10lld\n",
+                    qPrintable(r.corpus), qPrintable(r.engine), (long long)r.puzzles, (long long)r.solved,
+                    (long long)r.timeouts, (long long)r.wrong, r.puzzles_per_second, r.mean_ms, r.p50_ms,
+                    r.p99_ms, r.max_ms, r.guesses_per_puzzle, (long long)r.peak_rss_kb);
+            fflush(table);
+            results.append(toJson(r));
+        }
+    }
+
+    if(parser.isSet(jsonOption)){
+        QJsonObject report;
+        report["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+        report["cpu"] = QSysInfo::currentCpuArchitecture();
+        report["os"] = QSysInfo::prettyProductName();
+        report["timeout_ms"] = timeout_ms;
+        report["avx2"] = BitboardSolver::hasAvx2();
+        report["results"] = results;
+        QByteArray text = QJsonDocument(report).toJson();
+        if(json_to_stdout){
+            fwrite(text.constData(), 1, size_t(text.size()), stdout);
+        }
+        else{
+            QFile out(parser.value(jsonOption));
+            if(!out.open(QIODevice::WriteOnly)){
+                fprintf(stderr, "cannot write %s\n", qPrintable(parser.value(jsonOption)));
+                return 1;
+            }
+            out.write(text);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# Command-line batch solver, reads one puzzle per line
+#
+#-------------------------------------------------
+
+QT       = core network
+
+TARGET = sudoku-cli
+TEMPLATE = app
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+        main.cpp
+
+include(../core/sudokucore.pri)
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
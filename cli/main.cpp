@@ -0,0 +1,471 @@
+#include "sudokuboard.h"
+#include "sudokubatch.h"
+#include "sudokudatabase.h"
+#include "sudokuservice.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+// longest line that is read at once, longer lines are reported as invalid
+#define MAX_LINE_LENGTH 1024
+
+// puzzles of a database solved by one batch run, the results of one chunk are kept until they are written
+#define DATABASE_CHUNK_SIZE 65536
+
+// function to print the summary of a solve run on stderr
+static void printSummary(qint64 solved, qint64 unsolvable, qint64 invalid, double seconds)
+{
+    qint64 puzzles = solved+unsolvable+invalid;
+    fprintf(stderr, "%lld puzzles (%lld solved, %lld unsolvable, %lld invalid) in %.3f s, %.1f puzzles/s\n",
+            (long long)puzzles, (long long)solved, (long long)unsolvable, (long long)invalid, seconds, seconds > 0 ? puzzles/seconds : 0.0);
+}
+
+// function to solve (or with 'rate' only rate) every puzzle of the stream on a board with BOX_SIZE x BOX_SIZE boxes
+// and print the results, 'cache_size' > 0 keeps that many solutions for repeated and isomorphic 9x9 puzzles
+// with an 'output' database the results are appended to it instead of printed, invalid puzzles are left out
+template<int BOX_SIZE>
+static void solveStream(QFile& input, SOLVER_ENGINE engine, bool rate, int cache_size, SudokuDatabaseWriter* output)
+{
+    typedef SudokuBoardT<BOX_SIZE> BOARD;
+    BOARD sudoku;
+    sudoku.setEngine(engine);
+    SudokuSolveCache cache(qMax(1, cache_size));
+    if(cache_size > 0){
+        sudoku.setSolveCache(&cache);
+    }
+
+    QElapsedTimer timer;
+    QElapsedTimer total_timer;
+    total_timer.start();
+    char line[MAX_LINE_LENGTH];
+    char solution[BOARD::CELLS+1];
+    solution[BOARD::CELLS] = '\0';
+    val puzzle_values[BOARD::CELLS];
+    val solution_values[BOARD::CELLS];
+    qint64 solved = 0, unsolvable = 0, invalid = 0;
+
+    qint64 length;
+    while((length = input.readLine(line, sizeof(line))) > 0){
+        // skip the rest of a line that did not fit into the buffer
+        bool too_long = line[length-1] != '\n' && !input.atEnd();
+        if(too_long){
+            char rest[MAX_LINE_LENGTH];
+            qint64 n;
+            while((n = input.readLine(rest, sizeof(rest))) > 0 && rest[n-1] != '\n'){
+            }
+        }
+        while(length > 0 && (line[length-1] == '\n' || line[length-1] == '\r')){
+            line[--length] = '\0';
+        }
+        if(length == 0){
+            continue;
+        }
+
+        timer.start();
+        if(too_long || length < BOARD::CELLS || !sudoku.loadString(line)){
+            invalid++;
+            if(!output){
+                printf("%s\tinvalid\t0\n", line);
+            }
+            continue;
+        }
+        if(output){
+            sudoku.writeValues(puzzle_values);
+        }
+        if(rate){
+            DIFFICULTY_RATING rating = sudoku.rate();
+            qint64 us = timer.nsecsElapsed()/1000;
+            if(rating.valid){
+                solved++;
+            }
+            else{
+                unsolvable++;
+            }
+            if(output){
+                output->append(puzzle_values, nullptr, rating.valid ? rating.rating : -1);
+            }
+            else{
+                printf("%s\t%.1f\t%lld\t%s\n", line, rating.rating, (long long)us, qPrintable(BOARD::formatRating(rating)));
+            }
+            continue;
+        }
+        bool ok = sudoku.solve();
+        qint64 us = timer.nsecsElapsed()/1000;
+        if(ok){
+            solved++;
+            if(!output){
+                sudoku.writeString(solution);
+            }
+        }
+        else{
+            unsolvable++;
+            line[BOARD::CELLS] = '\0';
+        }
+        if(output){
+            if(ok){
+                sudoku.writeValues(solution_values);
+            }
+            output->append(puzzle_values, ok ? solution_values : nullptr);
+        }
+        else{
+            printf("%s\t%s\t%lld\n", ok ? solution : line, ok ? "solved" : "unsolvable", (long long)us);
+        }
+    }
+
+    printSummary(solved, unsolvable, invalid, total_timer.nsecsElapsed()/1e9);
+    if(cache_size > 0 && BOX_SIZE == SUDOKU_BOX_SIZE){
+        fprintf(stderr, "solve cache: %lld hits, %lld misses\n", (long long)cache.getHits(), (long long)cache.getMisses());
+    }
+}
+
+// function to solve (or with 'rate' only rate) every puzzle of a 9x9 database on all cores and print the results
+// in database order, or append them to the 'output' database; the records are read straight from the memory map
+// chunk by chunk, so only the pages of the current chunk are loaded
+static void solveDatabase(const SudokuDatabase& database, SOLVER_ENGINE engine, bool rate, int cache_size, SudokuDatabaseWriter* output)
+{
+    // result of one puzzle of the chunk
+    typedef struct {
+        bool loaded;
+        bool ok;
+        qint64 us;
+        val values[CELL_COUNT];     // solution when solved, the puzzle otherwise
+        DIFFICULTY_RATING rating;
+    } DATABASE_RESULT;
+
+    SudokuBatch batch;
+    batch.setEngine(engine);
+    SudokuSolveCache cache(qMax(1, cache_size));
+    if(cache_size > 0){
+        batch.setSolveCache(&cache);
+    }
+
+    QElapsedTimer total_timer;
+    total_timer.start();
+    qint64 solved = 0, unsolvable = 0, invalid = 0;
+    std::vector<DATABASE_RESULT> results(size_t(qMin<qint64>(DATABASE_CHUNK_SIZE, database.count())));
+    val puzzle[CELL_COUNT];
+    char text[CELL_COUNT+1];
+    text[CELL_COUNT] = '\0';
+
+    for(qint64 first=0; first<database.count(); first+=DATABASE_CHUNK_SIZE){
+        qint64 n = qMin<qint64>(DATABASE_CHUNK_SIZE, database.count()-first);
+        batch.run(n, [&](qint64 i, SudokuBoard& sudoku){
+            DATABASE_RESULT& r = results[size_t(i)];
+            QElapsedTimer timer;
+            timer.start();
+            database.readPuzzle(first+i, r.values);
+            r.loaded = sudoku.loadValues(r.values);
+            r.ok = false;
+            if(r.loaded && rate){
+                r.rating = sudoku.rate();
+                r.ok = r.rating.valid;
+            }
+            else if(r.loaded){
+                r.ok = sudoku.solve();
+                if(r.ok){
+                    sudoku.writeValues(r.values);
+                }
+            }
+            r.us = timer.nsecsElapsed()/1000;
+            return r.ok;
+        });
+
+        for(qint64 i=0; i<n; i++){
+            const DATABASE_RESULT& r = results[size_t(i)];
+            SudokuBoard::encodeStrings(r.values, 1, text);
+            if(!r.loaded){
+                invalid++;
+                if(!output){
+                    printf("%s\tinvalid\t0\n", text);
+                }
+                continue;
+            }
+            if(r.ok){
+                solved++;
+            }
+            else{
+                unsolvable++;
+            }
+            if(output){
+                database.readPuzzle(first+i, puzzle);
+                if(rate){
+                    output->append(puzzle, nullptr, r.ok ? r.rating.rating : -1);
+                }
+                else{
+                    output->append(puzzle, r.ok ? r.values : nullptr);
+                }
+            }
+            else if(rate){
+                printf("%s\t%.1f\t%lld\t%s\n", text, r.rating.rating, (long long)r.us, qPrintable(SudokuBoard::formatRating(r.rating)));
+            }
+            else{
+                printf("%s\t%s\t%lld\n", text, r.ok ? "solved" : "unsolvable", (long long)r.us);
+            }
+        }
+    }
+
+    printSummary(solved, unsolvable, invalid, total_timer.nsecsElapsed()/1e9);
+    if(cache_size > 0){
+        fprintf(stderr, "solve cache: %lld hits, %lld misses\n", (long long)cache.getHits(), (long long)cache.getMisses());
+    }
+}
+
+// function to print 'count' generated puzzles with a unique solution, one per line, or to append them to 'output'
+// a 'seed' other than 0 makes the output reproducible
+template<int BOX_SIZE>
+static void generateStream(qint64 count, quint64 seed, GENERATOR_MODE mode, SudokuDatabaseWriter* output)
+{
+    typedef SudokuBoardT<BOX_SIZE> BOARD;
+    BOARD sudoku;
+    sudoku.setGeneratorMode(mode);
+    if(seed){
+        sudoku.setSeed(seed);
+    }
+    char puzzle[BOARD::CELLS+1];
+    puzzle[BOARD::CELLS] = '\0';
+    val puzzle_values[BOARD::CELLS];
+
+    QElapsedTimer total_timer;
+    total_timer.start();
+    for(qint64 i=0; i<count; i++){
+        sudoku.generateUnique();
+        if(output){
+            sudoku.writeValues(puzzle_values);
+            output->append(puzzle_values);
+        }
+        else{
+            sudoku.writeString(puzzle);
+            printf("%s\n", puzzle);
+        }
+    }
+
+    double seconds = total_timer.nsecsElapsed()/1e9;
+    fprintf(stderr, "%lld puzzles generated in %.3f s, %.1f puzzles/s\n",
+            (long long)count, seconds, seconds > 0 ? count/seconds : 0.0);
+}
+
+// function to open the input file named by the arguments, or standard input when there is none or it is '-'
+static bool openInput(QFile& input, const QStringList& args)
+{
+    if(args.isEmpty() || args.first() == "-"){
+        return input.open(stdin, QIODevice::ReadOnly);
+    }
+    input.setFileName(args.first());
+    if(!input.open(QIODevice::ReadOnly)){
+        fprintf(stderr, "cannot open %s\n", qPrintable(args.first()));
+        return false;
+    }
+    return true;
+}
+
+// function to answer the JSON requests of the input, one per line, until the input ends
+// responses are written to stdout as the requests finish
+static void serveStream(QFile& input, SudokuService& service)
+{
+    std::mutex output_lock;
+    SudokuService::RESPONSE_HANDLER write = [&output_lock](const QByteArray& response){
+        std::lock_guard<std::mutex> guard(output_lock);
+        fwrite(response.constData(), 1, size_t(response.size()), stdout);
+        fflush(stdout);
+    };
+    while(true){
+        QByteArray line = input.readLine();
+        if(line.isEmpty()){
+            break;
+        }
+        line = line.trimmed();
+        if(!line.isEmpty()){
+            service.submit(line, write);
+        }
+    }
+    service.waitForIdle();
+}
+
+// function to answer the JSON requests of the clients of the local socket 'name' (a Unix domain socket,
+// a named pipe on Windows) while the event loop runs, the complete lines of every read are submitted together
+static bool serveSocket(const QString& name, SudokuService& service)
+{
+    QLocalServer* server = new QLocalServer(QCoreApplication::instance());
+    QLocalServer::removeServer(name);
+    if(!server->listen(name)){
+        fprintf(stderr, "cannot listen on %s: %s\n", qPrintable(name), qPrintable(server->errorString()));
+        return false;
+    }
+    QObject::connect(server, &QLocalServer::newConnection, [server, &service](){
+        while(QLocalSocket* socket = server->nextPendingConnection()){
+            QObject::connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+            QObject::connect(socket, &QLocalSocket::readyRead, socket, [socket, server, &service](){
+                QVector<QByteArray> requests;
+                while(socket->canReadLine()){
+                    QByteArray line = socket->readLine().trimmed();
+                    if(!line.isEmpty()){
+                        requests.push_back(line);
+                    }
+                }
+                // responses are written on the thread of the server, to the client if it is still connected
+                QPointer<QLocalSocket> client(socket);
+                service.submit(requests, [server, client](const QByteArray& response){
+                    QMetaObject::invokeMethod(server, [client, response](){
+                        if(client){
+                            client->write(response);
+                        }
+                    }, Qt::QueuedConnection);
+                });
+            });
+        }
+    });
+    fprintf(stderr, "listening on %s with %d threads\n", qPrintable(server->fullServerName()), service.getThreadCount());
+    return true;
+}
+
+// command-line batch solver
+// input: one puzzle per line, 81 characters for 9x9 boards (256 for --box 4, 625 for --box 5),
+//        values are '1'-'9' then 'A'-'P', '0' or '.' for empty cells,
+//        anything after the puzzle on the line is ignored, empty lines are skipped
+// output: one line per puzzle "<solution or input>\t<solved|unsolvable|invalid>\t<microseconds>"
+//         and a summary on stderr
+//         with --rate the puzzles are rated instead: "<input>\t<rating>\t<microseconds>\t<techniques used>"
+// the input is streamed line by line, so memory use does not depend on the number of puzzles
+// with --generate N no input is read, N puzzles with a unique solution are printed instead
+// a puzzle database (see sudokudatabase.h) is accepted as input and solved on all cores, with --output the
+// results are appended to a database instead of printed: puzzles and solutions, puzzles and ratings with --rate,
+// or the generated puzzles
+// with --serve the solver stays resident and answers JSON requests (see sudokuservice.h) read from the input,
+// or with --socket from the clients of a local socket
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("sudoku-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Solves Sudoku puzzles, one puzzle of 81 characters per line.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Puzzle file, standard input is read when missing or '-'.");
+    QCommandLineOption engineOption(QStringList() << "e" << "engine", "Solver engine: deduction (default), dlx or bitboard.", "engine", "deduction");
+    parser.addOption(engineOption);
+    QCommandLineOption boxOption(QStringList() << "b" << "box", "Box size: 3 (9x9, default), 4 (16x16) or 5 (25x25).", "size", "3");
+    parser.addOption(boxOption);
+    QCommandLineOption generateOption(QStringList() << "g" << "generate", "Print <count> generated puzzles with a unique solution instead of solving.", "count");
+    parser.addOption(generateOption);
+    QCommandLineOption seedOption(QStringList() << "s" << "seed", "Seed of the generator, the same seed generates the same puzzles.", "seed");
+    parser.addOption(seedOption);
+    QCommandLineOption permuteOption(QStringList() << "p" << "permute", "Generate grids by permuting seed grids instead of backtracking.");
+    parser.addOption(permuteOption);
+    QCommandLineOption rateOption(QStringList() << "r" << "rate", "Rate the difficulty of the puzzles instead of solving them.");
+    parser.addOption(rateOption);
+    QCommandLineOption cacheOption(QStringList() << "c" << "cache", "Keep up to <entries> solutions and answer repeated or isomorphic 9x9 puzzles from them.", "entries", "0");
+    parser.addOption(cacheOption);
+    QCommandLineOption outputOption(QStringList() << "o" << "output", "Append the results to the 9x9 puzzle database <file> instead of printing them.", "file");
+    parser.addOption(outputOption);
+    QCommandLineOption serveOption("serve", "Answer JSON requests, one per line, instead of solving puzzles.");
+    parser.addOption(serveOption);
+    QCommandLineOption socketOption("socket", "Serve the clients of the local socket <name> instead of standard input.", "name");
+    parser.addOption(socketOption);
+    parser.process(a);
+
+    SOLVER_ENGINE engine = ENGINE_DEDUCTION;
+    QString engine_name = parser.value(engineOption);
+    if(engine_name == "dlx"){
+        engine = ENGINE_DLX;
+    }
+    else if(engine_name == "bitboard"){
+        engine = ENGINE_BITBOARD;
+    }
+    else if(engine_name != "deduction"){
+        fprintf(stderr, "unknown engine %s\n", qPrintable(engine_name));
+        return 1;
+    }
+
+    int box = parser.value(boxOption).toInt();
+    if(box < 3 || box > 5){
+        fprintf(stderr, "unsupported box size %s\n", qPrintable(parser.value(boxOption)));
+        return 1;
+    }
+
+    if(parser.isSet(serveOption)){
+        if(box != SUDOKU_BOX_SIZE){
+            fprintf(stderr, "the service solves 9x9 puzzles only\n");
+            return 1;
+        }
+        int cache_size = parser.value(cacheOption).toInt();
+        SudokuSolveCache cache(qMax(1, cache_size));
+        SudokuService service;
+        service.setEngine(engine);
+        if(cache_size > 0){
+            service.setSolveCache(&cache);
+        }
+        if(parser.isSet(socketOption)){
+            return serveSocket(parser.value(socketOption), service) ? a.exec() : 1;
+        }
+        QFile input;
+        if(!openInput(input, parser.positionalArguments())){
+            return 1;
+        }
+        serveStream(input, service);
+        return 0;
+    }
+
+    SudokuDatabaseWriter writer;
+    SudokuDatabaseWriter* output = nullptr;
+    if(parser.isSet(outputOption)){
+        if(box != SUDOKU_BOX_SIZE){
+            fprintf(stderr, "puzzle databases hold 9x9 puzzles only\n");
+            return 1;
+        }
+        int columns = parser.isSet(generateOption) ? DB_PUZZLES : (parser.isSet(rateOption) ? DB_RATINGS : DB_SOLUTIONS);
+        if(!writer.open(parser.value(outputOption), columns)){
+            fprintf(stderr, "cannot open %s: %s\n", qPrintable(parser.value(outputOption)), qPrintable(writer.getError()));
+            return 1;
+        }
+        output = &writer;
+    }
+
+    if(parser.isSet(generateOption)){
+        qint64 count = parser.value(generateOption).toLongLong();
+        quint64 seed = parser.value(seedOption).toULongLong();
+        GENERATOR_MODE mode = parser.isSet(permuteOption) ? GENERATE_PERMUTATION : GENERATE_BACKTRACKING;
+        if(box == 4){
+            generateStream<4>(count, seed, mode, output);
+        }
+        else if(box == 5){
+            generateStream<5>(count, seed, mode, output);
+        }
+        else{
+            generateStream<3>(count, seed, mode, output);
+        }
+        return writer.close() ? 0 : 1;
+    }
+
+    QFile input;
+    const QStringList args = parser.positionalArguments();
+    if(!args.isEmpty() && SudokuDatabase::isDatabase(args.first())){
+        SudokuDatabase database;
+        if(box != SUDOKU_BOX_SIZE || !database.open(args.first())){
+            fprintf(stderr, "cannot open %s: %s\n", qPrintable(args.first()), box != SUDOKU_BOX_SIZE ? "puzzle databases hold 9x9 puzzles only" : qPrintable(database.getError()));
+            return 1;
+        }
+        solveDatabase(database, engine, parser.isSet(rateOption), parser.value(cacheOption).toInt(), output);
+        return writer.close() ? 0 : 1;
+    }
+    if(!openInput(input, args)){
+        return 1;
+    }
+
+    if(box == 4){
+        solveStream<4>(input, engine, parser.isSet(rateOption), parser.value(cacheOption).toInt(), output);
+    }
+    else if(box == 5){
+        solveStream<5>(input, engine, parser.isSet(rateOption), parser.value(cacheOption).toInt(), output);
+    }
+    else{
+        solveStream<3>(input, engine, parser.isSet(rateOption), parser.value(cacheOption).toInt(), output);
+    }
+    return writer.close() ? 0 : 1;
+}
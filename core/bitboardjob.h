@@ -0,0 +1,26 @@
+#ifndef BITBOARDJOB_H
+#define BITBOARDJOB_H
+
+#include "sudokugrid.h"
+
+// search request and statistics shared between BitboardSolver and its kernels
+// this header is all the kernels include: it is kept free of Qt and std::function,
+// so that the AVX2 kernel does not compile any inline code shared with the rest of the build
+typedef struct {
+    const val* puzzle;                  // CELL_COUNT values, 0 is an empty cell
+    val* solution;                      // first solution found
+    int limit;                          // counting stops after 'limit' solutions
+    bool (*abort_check)(void* context); // polled during the search, returning true stops it
+    void* abort_context;
+    int found;                          // number of solutions found
+    long long guesses;                  // candidates tried in branching cells
+    long long backtracks;               // dead ends reached by the propagation
+    int depth;                          // current number of nested guesses
+    bool aborted;
+} BITBOARD_JOB;
+
+// kernel entry points, the AVX2 one exists only when BITBOARD_HAVE_AVX2 is defined by the build
+void bitboardSearchScalar(BITBOARD_JOB& job);
+void bitboardSearchAvx2(BITBOARD_JOB& job);
+
+#endif // BITBOARDJOB_H
@@ -0,0 +1,392 @@
+#ifndef BITBOARDKERNEL_H
+#define BITBOARDKERNEL_H
+
+// search kernel of BitboardSolver, included by the scalar and by the AVX2 translation unit
+// everything here lives in an anonymous namespace: every translation unit gets its own copy
+// compiled with its own instruction set and nothing built for AVX2 can be shared with the scalar build
+
+#include "bitboardjob.h"
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// a line of the grid (a row, or a column in the transposed grid) is a vector of 16 lanes of 16 bits
+// cell 'i' of a line is kept in lane BITBOARD_LANE(i), so that every box stays inside one 128 bit half:
+// lanes 0-2, 4-6 and 8-10, lanes 3, 7 and 11-15 are always empty
+#define BITBOARD_LANES 16
+#define BITBOARD_LANE(i) ((i)+(i)/SUDOKU_BOX_SIZE)
+// how many guesses are made between two abort checks
+#define BITBOARD_ABORT_CHECK_INTERVAL 4096
+
+namespace {
+
+// index of the lowest set bit, the mask must not be empty
+inline int lowestBit(std::uint32_t m)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, m);
+    return int(index);
+#else
+    return __builtin_ctz(m);
+#endif
+}
+
+// number of set bits of a candidate mask
+inline int bitCount(std::uint32_t m)
+{
+    int n = 0;
+    for(; m; m &= m-1){
+        n++;
+    }
+    return n;
+}
+
+// backtracking search over candidate bitboards, OPS provides the vector type and its operations:
+// set1, load, store, bitAnd, bitOr, andNot (a & ~b), equalMask and singleMask (all ones in matching lanes),
+// laneBits (bit i set for every all ones lane i), isZero and shiftDown<n> (lane i gets lane i+n of its 128 bit half)
+template<class OPS>
+class BitboardKernel
+{
+public:
+    typedef typename OPS::VEC VEC;
+
+    explicit BitboardKernel(BITBOARD_JOB& job) :
+        job(job)
+    {
+        std::uint16_t lanes[BITBOARD_LANES] = {0};
+        for(int i=0; i<SUDOKU_BOARD_SIDE; i++){
+            lanes[BITBOARD_LANE(i)] = 0xFFFF;
+        }
+        valid = OPS::load(lanes);
+        all_values = OPS::bitAnd(valid, OPS::set1(DEFAULT_CANDIDATES));
+        zero = OPS::set1(0);
+
+        for(int i=0; i<BITBOARD_LANES; i++){
+            cell_of_lane[i] = -1;
+        }
+        for(int i=0; i<SUDOKU_BOARD_SIDE; i++){
+            cell_of_lane[BITBOARD_LANE(i)] = i;
+            lane[i] = laneVector(1u << BITBOARD_LANE(i));
+            line_peers[i] = OPS::andNot(valid, lane[i]);
+        }
+        std::uint32_t head_bits = 0;
+        for(int b=0; b<SUDOKU_BOX_SIZE; b++){
+            int first = BITBOARD_LANE(b*SUDOKU_BOX_SIZE);
+            box_lane_bits[b] = ((1u << SUDOKU_BOX_SIZE)-1) << first;
+            head_bits |= 1u << first;
+        }
+        box_heads = laneVector(head_bits);
+        for(int i=0; i<SUDOKU_BOARD_SIDE; i++){
+            box_peers[i] = laneVector(box_lane_bits[i/SUDOKU_BOX_SIZE]);
+        }
+    }
+
+    // function to run the search described by the job
+    void run()
+    {
+        STATE s;
+        for(int k=0; k<SUDOKU_BOARD_SIDE; k++){
+            s.grid[k] = all_values;
+            s.trans[k] = all_values;
+            s.solved[k] = zero;
+            s.solved_trans[k] = zero;
+        }
+        s.remaining = CELL_COUNT;
+
+        // place the clues, a clue that is no longer a candidate conflicts with an earlier one
+        for(int i=0; i<CELL_COUNT; i++){
+            val v = job.puzzle[i];
+            if(!v){
+                continue;
+            }
+            int row = i/SUDOKU_BOARD_SIDE;
+            int col = i%SUDOKU_BOARD_SIDE;
+            cmask bit = cmask(1u << (v-1));
+            if(!(cell(s.grid[row], col) & bit)){
+                return;
+            }
+            place(s, row, col, bit);
+        }
+        search(s);
+    }
+
+private:
+    // candidates of every cell in both orientations, solved cells keep the mask of their value
+    typedef struct {
+        VEC grid[SUDOKU_BOARD_SIDE];            // row r, lane of column c
+        VEC trans[SUDOKU_BOARD_SIDE];           // column c, lane of row r
+        VEC solved[SUDOKU_BOARD_SIDE];          // all ones in the lanes of solved cells of grid
+        VEC solved_trans[SUDOKU_BOARD_SIDE];    // all ones in the lanes of solved cells of trans
+        int remaining;                          // number of unsolved cells
+    } STATE;
+
+    BITBOARD_JOB& job;
+    VEC valid;                                  // lanes used by cells
+    VEC all_values;                             // every candidate in every used lane
+    VEC zero;
+    VEC box_heads;                              // first lane of every box
+    VEC lane[SUDOKU_BOARD_SIDE];                // lane of cell i
+    VEC line_peers[SUDOKU_BOARD_SIDE];          // lanes of the other cells of the same line
+    VEC box_peers[SUDOKU_BOARD_SIDE];           // lanes of the box of cell i
+    std::uint32_t box_lane_bits[SUDOKU_BOX_SIZE];     // laneBits of every box
+    int cell_of_lane[BITBOARD_LANES];           // inverse of BITBOARD_LANE, -1 for unused lanes
+
+    // vector with all ones in the lanes set in 'bits'
+    static VEC laneVector(std::uint32_t bits)
+    {
+        std::uint16_t lanes[BITBOARD_LANES];
+        for(int i=0; i<BITBOARD_LANES; i++){
+            lanes[i] = (bits >> i) & 1 ? 0xFFFF : 0;
+        }
+        return OPS::load(lanes);
+    }
+
+    // candidates of cell 'i' of a line
+    static cmask cell(const VEC& line, int i)
+    {
+        std::uint16_t lanes[BITBOARD_LANES];
+        OPS::store(line, lanes);
+        return lanes[BITBOARD_LANE(i)];
+    }
+
+    // laneBits of the unsolved cells of a line that still have candidate 'bit'
+    std::uint32_t cellsWith(const VEC& line, const VEC& solved, cmask bit) const
+    {
+        VEC missing = OPS::equalMask(OPS::bitAnd(line, OPS::set1(bit)), zero);
+        return OPS::laneBits(OPS::andNot(OPS::andNot(valid, solved), missing));
+    }
+
+    // function to solve cell (row,col) with the value of 'bit' and remove it from the peers
+    // peers are the whole line in the same row, the box lanes in the same band and the column lane elsewhere
+    void place(STATE& s, int row, int col, cmask bit)
+    {
+        VEC b = OPS::set1(bit);
+        for(int k=0; k<SUDOKU_BOARD_SIDE; k++){
+            const VEC& grid_peers = k == row ? line_peers[col] : k/SUDOKU_BOX_SIZE == row/SUDOKU_BOX_SIZE ? box_peers[col] : lane[col];
+            s.grid[k] = OPS::andNot(s.grid[k], OPS::bitAnd(grid_peers, b));
+            const VEC& trans_peers = k == col ? line_peers[row] : k/SUDOKU_BOX_SIZE == col/SUDOKU_BOX_SIZE ? box_peers[row] : lane[row];
+            s.trans[k] = OPS::andNot(s.trans[k], OPS::bitAnd(trans_peers, b));
+        }
+        s.grid[row] = OPS::bitOr(OPS::andNot(s.grid[row], lane[col]), OPS::bitAnd(lane[col], b));
+        s.trans[col] = OPS::bitOr(OPS::andNot(s.trans[col], lane[row]), OPS::bitAnd(lane[row], b));
+        s.solved[row] = OPS::bitOr(s.solved[row], lane[col]);
+        s.solved_trans[col] = OPS::bitOr(s.solved_trans[col], lane[row]);
+        s.remaining--;
+    }
+
+    // function to solve the cells with one candidate, all cells of a row at once
+    // returns -1 on an empty cell, 1 if a cell was solved, 0 otherwise
+    int nakedSingles(STATE& s)
+    {
+        int result = 0;
+        for(int row=0; row<SUDOKU_BOARD_SIDE; row++){
+            VEC open = OPS::andNot(valid, s.solved[row]);
+            if(OPS::laneBits(OPS::bitAnd(open, OPS::equalMask(s.grid[row], zero)))){
+                return -1;
+            }
+            for(std::uint32_t m = OPS::laneBits(OPS::bitAnd(open, OPS::singleMask(s.grid[row]))); m; m &= m-1){
+                int col = cell_of_lane[lowestBit(m)];
+                // an earlier single of this row may have taken the value
+                cmask c = cell(s.grid[row], col);
+                if(!c){
+                    return -1;
+                }
+                place(s, row, col, c);
+                result = 1;
+            }
+        }
+        return result;
+    }
+
+    // function to add the lines to the counts of the candidates: 'once' has the candidates seen at least
+    // once, 'twice' at least twice and 'placed' the solved values, lane by lane
+    void countLines(const VEC* lines, const VEC* solved, int count, VEC& once, VEC& twice, VEC& placed) const
+    {
+        once = zero;
+        twice = zero;
+        placed = zero;
+        for(int k=0; k<count; k++){
+            VEC open = OPS::andNot(lines[k], solved[k]);
+            twice = OPS::bitOr(twice, OPS::bitAnd(once, open));
+            once = OPS::bitOr(once, open);
+            placed = OPS::bitOr(placed, OPS::bitAnd(lines[k], solved[k]));
+        }
+    }
+
+    // function to solve the values with one place left in a column (or a row when 'transposed')
+    // the 9 lines are counted together, lane c ends with the counts of column c
+    // returns -1 when a value has no place in a unit, 1 if a cell was solved, 0 otherwise
+    int hiddenSinglesInLines(STATE& s, bool transposed)
+    {
+        const VEC* lines = transposed ? s.trans : s.grid;
+        const VEC* solved = transposed ? s.solved_trans : s.solved;
+        VEC once, twice, placed;
+        countLines(lines, solved, SUDOKU_BOARD_SIDE, once, twice, placed);
+        if(OPS::laneBits(OPS::andNot(valid, OPS::equalMask(OPS::bitOr(once, placed), all_values)))){
+            return -1;
+        }
+        VEC hidden = OPS::andNot(once, twice);
+        if(OPS::isZero(hidden)){
+            return 0;
+        }
+
+        int result = 0;
+        std::uint16_t lanes[BITBOARD_LANES];
+        OPS::store(hidden, lanes);
+        for(int i=0; i<SUDOKU_BOARD_SIDE; i++){
+            for(cmask m = lanes[BITBOARD_LANE(i)]; m; m &= m-1){
+                cmask bit = m & -m;
+                // the unit is a line of the other orientation
+                std::uint32_t where = transposed ? cellsWith(s.grid[i], s.solved[i], bit) : cellsWith(s.trans[i], s.solved_trans[i], bit);
+                if(!where){
+                    continue;
+                }
+                int j = cell_of_lane[lowestBit(where)];
+                if(transposed){
+                    place(s, i, j, bit);
+                }
+                else{
+                    place(s, j, i, bit);
+                }
+                result = 1;
+            }
+        }
+        return result;
+    }
+
+    // function to solve the values with one place left in a box, the 3 boxes of a band at once
+    // the rows of the band are counted together, then lanes 1 and 2 of every box are folded onto the first one
+    // returns -1 when a value has no place in a box, 1 if a cell was solved, 0 otherwise
+    int hiddenSinglesInBoxes(STATE& s)
+    {
+        int result = 0;
+        for(int band=0; band<SUDOKU_BOX_SIZE; band++){
+            int first_row = band*SUDOKU_BOX_SIZE;
+            VEC once, twice, placed;
+            countLines(s.grid+first_row, s.solved+first_row, SUDOKU_BOX_SIZE, once, twice, placed);
+            VEC once1 = OPS::template shiftDown<1>(once);
+            VEC twice1 = OPS::template shiftDown<1>(twice);
+            VEC once2 = OPS::template shiftDown<2>(once);
+            VEC twice2 = OPS::template shiftDown<2>(twice);
+            twice = OPS::bitOr(OPS::bitOr(twice, twice1), OPS::bitAnd(once, once1));
+            once = OPS::bitOr(once, once1);
+            twice = OPS::bitOr(OPS::bitOr(twice, twice2), OPS::bitAnd(once, once2));
+            once = OPS::bitOr(once, once2);
+            placed = OPS::bitOr(placed, OPS::bitOr(OPS::template shiftDown<1>(placed), OPS::template shiftDown<2>(placed)));
+            if(OPS::laneBits(OPS::andNot(box_heads, OPS::equalMask(OPS::bitOr(once, placed), all_values)))){
+                return -1;
+            }
+            VEC hidden = OPS::bitAnd(box_heads, OPS::andNot(once, twice));
+            if(OPS::isZero(hidden)){
+                continue;
+            }
+
+            std::uint16_t lanes[BITBOARD_LANES];
+            OPS::store(hidden, lanes);
+            for(int box=0; box<SUDOKU_BOX_SIZE; box++){
+                for(cmask m = lanes[BITBOARD_LANE(box*SUDOKU_BOX_SIZE)]; m; m &= m-1){
+                    cmask bit = m & -m;
+                    for(int row=first_row; row<first_row+SUDOKU_BOX_SIZE; row++){
+                        std::uint32_t where = cellsWith(s.grid[row], s.solved[row], bit) & box_lane_bits[box];
+                        if(where){
+                            place(s, row, cell_of_lane[lowestBit(where)], bit);
+                            result = 1;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    // function to apply singles until nothing changes, returns false when the board is broken
+    bool propagate(STATE& s)
+    {
+        while(s.remaining > 0){
+            int result = nakedSingles(s);
+            if(result < 0){
+                return false;
+            }
+            if(result > 0){
+                continue;
+            }
+            int columns = hiddenSinglesInLines(s, false);
+            int rows = columns < 0 ? -1 : hiddenSinglesInLines(s, true);
+            int boxes = rows < 0 ? -1 : hiddenSinglesInBoxes(s);
+            if(boxes < 0){
+                return false;
+            }
+            if(columns+rows+boxes == 0){
+                break;
+            }
+        }
+        return true;
+    }
+
+    // function to copy the solved board to the job solution
+    void writeSolution(const STATE& s)
+    {
+        for(int row=0; row<SUDOKU_BOARD_SIDE; row++){
+            std::uint16_t lanes[BITBOARD_LANES];
+            OPS::store(s.grid[row], lanes);
+            for(int col=0; col<SUDOKU_BOARD_SIDE; col++){
+                job.solution[row*SUDOKU_BOARD_SIDE+col] = val(lowestBit(lanes[BITBOARD_LANE(col)])+1);
+            }
+        }
+    }
+
+    // recursive search, branches on the unsolved cell with the fewest candidates
+    void search(STATE& s)
+    {
+        if(!propagate(s)){
+            job.backtracks++;
+            return;
+        }
+        if(s.remaining == 0){
+            if(job.found == 0){
+                writeSolution(s);
+            }
+            job.found++;
+            return;
+        }
+
+        int best = CANDIDATE_COUNT+1;
+        int best_row = 0;
+        int best_col = 0;
+        cmask best_candidates = NO_CANDIDATES;
+        for(int row=0; row<SUDOKU_BOARD_SIDE && best > 2; row++){
+            std::uint16_t lanes[BITBOARD_LANES];
+            OPS::store(s.grid[row], lanes);
+            for(std::uint32_t m = OPS::laneBits(OPS::andNot(valid, s.solved[row])); m; m &= m-1){
+                int l = lowestBit(m);
+                int n = bitCount(lanes[l]);
+                if(n < best){
+                    best = n;
+                    best_row = row;
+                    best_col = cell_of_lane[l];
+                    best_candidates = lanes[l];
+                }
+            }
+        }
+
+        job.depth++;
+        for(cmask m = best_candidates; m && job.found < job.limit && !job.aborted; m &= m-1){
+            job.guesses++;
+            if(job.abort_check && job.guesses%BITBOARD_ABORT_CHECK_INTERVAL == 0 && job.abort_check(job.abort_context)){
+                job.aborted = true;
+                break;
+            }
+            STATE child = s;
+            place(child, best_row, best_col, cmask(m & -m));
+            search(child);
+        }
+        job.depth--;
+    }
+};
+
+} // namespace
+
+#endif // BITBOARDKERNEL_H
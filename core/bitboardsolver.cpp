@@ -0,0 +1,236 @@
+#include "bitboardsolver.h"
+#include "bitboardkernel.h"
+
+#if defined(BITBOARD_HAVE_AVX2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+// portable kernel, a grid line is an array of lanes processed one by one
+typedef struct {
+    quint16 lane[BITBOARD_LANES];
+} SCALAR_VECTOR;
+
+struct ScalarOps
+{
+    typedef SCALAR_VECTOR VEC;
+
+    static inline VEC set1(quint16 x)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = x;
+        }
+        return r;
+    }
+
+    static inline VEC load(const quint16* lanes)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = lanes[i];
+        }
+        return r;
+    }
+
+    static inline void store(const VEC& v, quint16* lanes)
+    {
+        for(int i=0; i<BITBOARD_LANES; i++){
+            lanes[i] = v.lane[i];
+        }
+    }
+
+    static inline VEC bitAnd(const VEC& a, const VEC& b)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = a.lane[i] & b.lane[i];
+        }
+        return r;
+    }
+
+    static inline VEC bitOr(const VEC& a, const VEC& b)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = a.lane[i] | b.lane[i];
+        }
+        return r;
+    }
+
+    static inline VEC andNot(const VEC& a, const VEC& b)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = a.lane[i] & ~b.lane[i];
+        }
+        return r;
+    }
+
+    static inline VEC equalMask(const VEC& a, const VEC& b)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = a.lane[i] == b.lane[i] ? 0xFFFF : 0;
+        }
+        return r;
+    }
+
+    static inline VEC singleMask(const VEC& v)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = (v.lane[i] & (v.lane[i]-1)) == 0 ? 0xFFFF : 0;
+        }
+        return r;
+    }
+
+    static inline quint32 laneBits(const VEC& v)
+    {
+        quint32 bits = 0;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            bits |= quint32(v.lane[i] >> 15) << i;
+        }
+        return bits;
+    }
+
+    static inline bool isZero(const VEC& v)
+    {
+        quint16 any = 0;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            any |= v.lane[i];
+        }
+        return any == 0;
+    }
+
+    template<int n>
+    static inline VEC shiftDown(const VEC& v)
+    {
+        VEC r;
+        for(int i=0; i<BITBOARD_LANES; i++){
+            r.lane[i] = i%(BITBOARD_LANES/2)+n < BITBOARD_LANES/2 ? v.lane[i+n] : 0;
+        }
+        return r;
+    }
+};
+
+} // namespace
+
+// function to run the search of the job with the scalar kernel
+void bitboardSearchScalar(BITBOARD_JOB& job)
+{
+    BitboardKernel<ScalarOps> kernel(job);
+    kernel.run();
+}
+
+BitboardSolver::BitboardSolver() :
+    simd_enabled(true)
+{
+    job.puzzle = nullptr;
+    job.solution = nullptr;
+    job.limit = 1;
+    job.abort_check = nullptr;
+    job.abort_context = nullptr;
+    job.found = 0;
+    job.guesses = 0;
+    job.backtracks = 0;
+    job.depth = 0;
+    job.aborted = false;
+}
+
+// function to return true if the CPU and the operating system support AVX2
+bool BitboardSolver::hasAvx2()
+{
+#if !defined(BITBOARD_HAVE_AVX2)
+    return false;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7){
+        return false;
+    }
+    __cpuid(info, 1);
+    // OSXSAVE and AVX, then the OS has to save the YMM registers
+    if((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6){
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#endif
+}
+
+// function to solve the puzzle, see header
+int BitboardSolver::solve(const val* puzzle, val* solution, int limit)
+{
+    job.puzzle = puzzle;
+    job.solution = solution;
+    job.limit = limit;
+    job.abort_check = abort_check ? &BitboardSolver::callAbortCheck : nullptr;
+    job.abort_context = this;
+    job.found = 0;
+    job.guesses = 0;
+    job.backtracks = 0;
+    job.depth = 0;
+    job.aborted = false;
+
+#if defined(BITBOARD_HAVE_AVX2)
+    if(isUsingAvx2()){
+        bitboardSearchAvx2(job);
+        return job.found;
+    }
+#endif
+    bitboardSearchScalar(job);
+    return job.found;
+}
+
+// function forwarding the kernel abort check to the std::function
+bool BitboardSolver::callAbortCheck(void* solver)
+{
+    return static_cast<BitboardSolver*>(solver)->abort_check();
+}
+
+// function to set the function polled during the search
+void BitboardSolver::setAbortCheck(std::function<bool()> check)
+{
+    abort_check = check;
+}
+
+// function to return true if the last search was stopped by the abort check
+bool BitboardSolver::wasAborted() const
+{
+    return job.aborted;
+}
+
+// function to allow (default) or forbid the AVX2 kernel
+void BitboardSolver::setSimdEnabled(bool enabled)
+{
+    simd_enabled = enabled;
+}
+
+// function to return true if solve() runs the AVX2 kernel
+bool BitboardSolver::isUsingAvx2() const
+{
+    return simd_enabled && hasAvx2();
+}
+
+// function to return the number of candidates tried by the last search
+qint64 BitboardSolver::getGuessCount() const
+{
+    return job.guesses;
+}
+
+// function to return the number of dead ends of the last search
+qint64 BitboardSolver::getBacktrackCount() const
+{
+    return job.backtracks;
+}
+
+// function to return the current search depth
+int BitboardSolver::getDepth() const
+{
+    return job.depth;
+}
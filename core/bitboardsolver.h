@@ -0,0 +1,42 @@
+#ifndef BITBOARDSOLVER_H
+#define BITBOARDSOLVER_H
+
+#include "sudokutypes.h"
+#include "bitboardjob.h"
+#include <functional>
+
+// Sudoku solver working on candidate bitboards, rows and columns of the grid are kept in vector
+// registers so that eliminations and hidden singles of all 27 units are computed a few lines at a time
+// the AVX2 kernel is selected at runtime when the CPU supports it, otherwise a portable scalar kernel runs
+class BitboardSolver
+{
+public:
+    BitboardSolver();
+
+    // solve the puzzle given as CELL_COUNT values (0 is an empty cell)
+    // the first solution found is written to 'solution', counting stops after 'limit' solutions
+    // returns the number of solutions found, 0 for invalid or unsolvable puzzles
+    int solve(const val* puzzle, val* solution, int limit = 1);
+
+    // function polled during the search, returning true stops the search
+    void setAbortCheck(std::function<bool()> check);
+    bool wasAborted() const;
+
+    // false forces the scalar kernel even when AVX2 is available
+    void setSimdEnabled(bool enabled);
+    bool isUsingAvx2() const;
+    static bool hasAvx2();
+
+    qint64 getGuessCount() const;
+    qint64 getBacktrackCount() const;
+    int getDepth() const;
+
+private:
+    BITBOARD_JOB job;
+    std::function<bool()> abort_check;
+    bool simd_enabled;
+
+    static bool callAbortCheck(void* solver);
+};
+
+#endif // BITBOARDSOLVER_H
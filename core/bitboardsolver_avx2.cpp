@@ -0,0 +1,47 @@
+// AVX2 kernel of BitboardSolver, this file is compiled with AVX2 code generation (AVX2_SOURCES)
+// and is only called after BitboardSolver::hasAvx2() confirmed the CPU support
+#include "bitboardkernel.h"
+#include <immintrin.h>
+
+namespace {
+
+// a whole grid line in one 256 bit register
+struct Avx2Ops
+{
+    typedef __m256i VEC;
+
+    static inline VEC set1(std::uint16_t x){ return _mm256_set1_epi16(short(x)); }
+    static inline VEC load(const std::uint16_t* lanes){ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes)); }
+    static inline void store(const VEC& v, std::uint16_t* lanes){ _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), v); }
+    static inline VEC bitAnd(const VEC& a, const VEC& b){ return _mm256_and_si256(a, b); }
+    static inline VEC bitOr(const VEC& a, const VEC& b){ return _mm256_or_si256(a, b); }
+    static inline VEC andNot(const VEC& a, const VEC& b){ return _mm256_andnot_si256(b, a); }
+    static inline VEC equalMask(const VEC& a, const VEC& b){ return _mm256_cmpeq_epi16(a, b); }
+    static inline bool isZero(const VEC& v){ return _mm256_testz_si256(v, v); }
+
+    // lanes with at most one bit set: v & (v-1) == 0
+    static inline VEC singleMask(const VEC& v)
+    {
+        VEC cleared = _mm256_and_si256(v, _mm256_sub_epi16(v, _mm256_set1_epi16(1)));
+        return _mm256_cmpeq_epi16(cleared, _mm256_setzero_si256());
+    }
+
+    // all ones lanes pack to 0xFF bytes, one movemask bit per lane
+    static inline std::uint32_t laneBits(const VEC& v)
+    {
+        __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        return std::uint32_t(_mm_movemask_epi8(packed));
+    }
+
+    template<int n>
+    static inline VEC shiftDown(const VEC& v){ return _mm256_srli_si256(v, 2*n); }
+};
+
+} // namespace
+
+// function to run the search of the job with the AVX2 kernel
+void bitboardSearchAvx2(BITBOARD_JOB& job)
+{
+    BitboardKernel<Avx2Ops> kernel(job);
+    kernel.run();
+}
@@ -0,0 +1,45 @@
+#-------------------------------------------------
+#
+# Headless Sudoku solver library, no QtGui/QtWidgets dependency
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = sudokucore
+TEMPLATE = lib
+CONFIG += staticlib c++11
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    sudokuboard.cpp \
+    sudokubatch.cpp \
+    sudokucache.cpp \
+    sudokudatabase.cpp \
+    sudokuservice.cpp \
+    dlxsolver.cpp \
+    bitboardsolver.cpp
+
+HEADERS += \
+    sudokuboard.h \
+    sudokubatch.h \
+    sudokutypes.h \
+    sudokugrid.h \
+    sudokurandom.h \
+    sudokutrace.h \
+    sudokucache.h \
+    sudokudatabase.h \
+    sudokuservice.h \
+    dlxsolver.h \
+    bitboardsolver.h \
+    bitboardjob.h \
+    bitboardkernel.h
+
+# the AVX2 bitboard kernel is compiled with AVX2 code generation on x86 only,
+# BitboardSolver calls it after checking the CPU at runtime
+contains(QT_ARCH, x86_64)|contains(QT_ARCH, i386) {
+    CONFIG += simd
+    AVX2_SOURCES += bitboardsolver_avx2.cpp
+    DEFINES += BITBOARD_HAVE_AVX2
+}
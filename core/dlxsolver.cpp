@@ -0,0 +1,248 @@
+#include "dlxsolver.h"
+
+#define DLX_ROOT COLUMNS
+#define DLX_NODE_COUNT (COLUMNS+1+4*ROWS)
+// how many search nodes are visited between two abort checks
+#define DLX_ABORT_CHECK_INTERVAL 4096
+
+template<int BOX_SIZE>
+DlxSolverT<BOX_SIZE>::DlxSolverT() :
+    aborted(false),
+    nodes(0),
+    backtracks(0),
+    depth(0),
+    found(0),
+    solution_out(nullptr),
+    puzzle_in(nullptr)
+{
+    build();
+}
+
+// function to build the exact cover matrix with all ROWS rows
+template<int BOX_SIZE>
+void DlxSolverT<BOX_SIZE>::build()
+{
+    left.resize(DLX_NODE_COUNT);
+    right.resize(DLX_NODE_COUNT);
+    up.resize(DLX_NODE_COUNT);
+    down.resize(DLX_NODE_COUNT);
+    column.resize(DLX_NODE_COUNT);
+    row_of.resize(DLX_NODE_COUNT);
+    row_start.resize(ROWS);
+    size.assign(COLUMNS, 0);
+    chosen.assign(CELLS, 0);
+
+    // column headers in a circular list with the root
+    for(int c=0; c<=DLX_ROOT; c++){
+        left[c] = c == 0 ? DLX_ROOT : c-1;
+        right[c] = c == DLX_ROOT ? 0 : c+1;
+        up[c] = c;
+        down[c] = c;
+        column[c] = c;
+        row_of[c] = -1;
+    }
+
+    int n = DLX_ROOT+1;
+    for(int cell=0; cell<CELLS; cell++){
+        int row = cell/SIDE;
+        int col = cell%SIDE;
+        int box = (row/BOX)*BOX + col/BOX;
+        for(int d=0; d<SIDE; d++){
+            int r = cell*SIDE+d;
+            int columns[4] = {
+                cell,                   // cell has a value
+                CELLS + row*SIDE+d,     // row has value d+1
+                2*CELLS + col*SIDE+d,   // column has value d+1
+                3*CELLS + box*SIDE+d    // box has value d+1
+            };
+            row_start[r] = n;
+            for(int k=0; k<4; k++){
+                int c = columns[k];
+                // horizontal circular list of the row
+                left[n] = k == 0 ? n+3 : n-1;
+                right[n] = k == 3 ? n-3 : n+1;
+                // append to the bottom of the column
+                up[n] = up[c];
+                down[n] = c;
+                down[up[c]] = n;
+                up[c] = n;
+                column[n] = c;
+                row_of[n] = r;
+                size[c]++;
+                n++;
+            }
+        }
+    }
+}
+
+// function to remove column 'c' and all rows covering it from the matrix
+template<int BOX_SIZE>
+void DlxSolverT<BOX_SIZE>::cover(int c)
+{
+    right[left[c]] = right[c];
+    left[right[c]] = left[c];
+    for(int i=down[c]; i!=c; i=down[i]){
+        for(int j=right[i]; j!=i; j=right[j]){
+            down[up[j]] = down[j];
+            up[down[j]] = up[j];
+            size[column[j]]--;
+        }
+    }
+}
+
+// function to put column 'c' back, exact reverse of cover
+template<int BOX_SIZE>
+void DlxSolverT<BOX_SIZE>::uncover(int c)
+{
+    for(int i=up[c]; i!=c; i=up[i]){
+        for(int j=left[i]; j!=i; j=left[j]){
+            size[column[j]]++;
+            down[up[j]] = j;
+            up[down[j]] = j;
+        }
+    }
+    right[left[c]] = c;
+    left[right[c]] = c;
+}
+
+// recursive Algorithm X search, branches on the column with the fewest rows
+// returns the number of solutions found, up to 'limit'
+template<int BOX_SIZE>
+int DlxSolverT<BOX_SIZE>::search(int limit)
+{
+    if(right[DLX_ROOT] == DLX_ROOT){
+        if(found == 0){
+            for(int i=0; i<CELLS; i++){
+                solution_out[i] = puzzle_in[i];
+            }
+            for(int i=0; i<depth; i++){
+                solution_out[chosen[i]/SIDE] = val(chosen[i]%SIDE+1);
+            }
+        }
+        found++;
+        return 1;
+    }
+
+    int c = right[DLX_ROOT];
+    for(int j=right[c]; j!=DLX_ROOT && size[c]>1; j=right[j]){
+        if(size[j] < size[c]){
+            c = j;
+        }
+    }
+    if(size[c] == 0){
+        backtracks++;
+        return 0;
+    }
+
+    int count = 0;
+    cover(c);
+    for(int r=down[c]; r!=c && count<limit && !aborted; r=down[r]){
+        nodes++;
+        if(abort_check && nodes%DLX_ABORT_CHECK_INTERVAL == 0 && abort_check()){
+            aborted = true;
+        }
+        chosen[depth++] = row_of[r];
+        for(int j=right[r]; j!=r; j=right[j]){
+            cover(column[j]);
+        }
+        count += search(limit-count);
+        for(int j=left[r]; j!=r; j=left[j]){
+            uncover(column[j]);
+        }
+        depth--;
+    }
+    uncover(c);
+    if(count == 0){
+        backtracks++;
+    }
+    return count;
+}
+
+// function to solve the puzzle, see header
+template<int BOX_SIZE>
+int DlxSolverT<BOX_SIZE>::solve(const val* puzzle, val* solution, int limit)
+{
+    aborted = false;
+    nodes = 0;
+    backtracks = 0;
+    depth = 0;
+    found = 0;
+    solution_out = solution;
+    puzzle_in = puzzle;
+
+    // select the rows of the clues, conflicting clues make the puzzle invalid
+    int clue_rows[CELLS];
+    int clue_count = 0;
+    bool valid = true;
+    for(int cell=0; cell<CELLS && valid; cell++){
+        if(!puzzle[cell]){
+            continue;
+        }
+        int first = row_start[cell*SIDE+puzzle[cell]-1];
+        // every column of the row has to be still uncovered
+        for(int j=first, k=0; k<4; j=right[j], k++){
+            int c = column[j];
+            if(right[left[c]] != c){
+                valid = false;
+            }
+        }
+        if(!valid){
+            break;
+        }
+        for(int j=first, k=0; k<4; j=right[j], k++){
+            cover(column[j]);
+        }
+        clue_rows[clue_count++] = first;
+    }
+
+    int count = valid ? search(limit) : 0;
+
+    // restore the full matrix, clues are uncovered in reverse order
+    for(int i=clue_count-1; i>=0; i--){
+        int first = clue_rows[i];
+        for(int j=left[first], k=0; k<4; j=left[j], k++){
+            uncover(column[j]);
+        }
+    }
+    return count;
+}
+
+// function to set the function polled during the search
+template<int BOX_SIZE>
+void DlxSolverT<BOX_SIZE>::setAbortCheck(std::function<bool()> check)
+{
+    abort_check = check;
+}
+
+// function to return true if the last search was stopped by the abort check
+template<int BOX_SIZE>
+bool DlxSolverT<BOX_SIZE>::wasAborted() const
+{
+    return aborted;
+}
+
+// function to return the number of matrix rows tried by the last search
+template<int BOX_SIZE>
+qint64 DlxSolverT<BOX_SIZE>::getNodeCount() const
+{
+    return nodes;
+}
+
+// function to return the number of dead ends of the last search
+template<int BOX_SIZE>
+qint64 DlxSolverT<BOX_SIZE>::getBacktrackCount() const
+{
+    return backtracks;
+}
+
+// function to return the current search depth (number of rows selected besides the clues)
+template<int BOX_SIZE>
+int DlxSolverT<BOX_SIZE>::getDepth() const
+{
+    return depth;
+}
+
+// the solver is compiled for these box sizes only
+template class DlxSolverT<3>;
+template class DlxSolverT<4>;
+template class DlxSolverT<5>;
@@ -0,0 +1,64 @@
+#ifndef DLXSOLVER_H
+#define DLXSOLVER_H
+
+#include "sudokutypes.h"
+#include <vector>
+#include <functional>
+
+// Sudoku solver using Knuth's Algorithm X with dancing links over the exact cover matrix
+// the matrix is built once and restored after every solve, solving does not allocate
+// BOX_SIZE is the size of a box, the board has BOX_SIZE^2 rows, columns and values
+template<int BOX_SIZE>
+class DlxSolverT
+{
+public:
+    enum {
+        BOX = BOX_SIZE,
+        SIDE = BOX_SIZE*BOX_SIZE,
+        CELLS = SIDE*SIDE,
+        // exact cover columns: each cell has a value, each row, column and box has every value once
+        COLUMNS = 4*CELLS,
+        // exact cover rows: one row for every value in every cell
+        ROWS = CELLS*SIDE
+    };
+
+    DlxSolverT();
+
+    // solve the puzzle given as CELLS values (0 is an empty cell)
+    // the first solution found is written to 'solution', counting stops after 'limit' solutions
+    // returns the number of solutions found, 0 for invalid or unsolvable puzzles
+    int solve(const val* puzzle, val* solution, int limit = 1);
+
+    // function polled during the search, returning true stops the search
+    void setAbortCheck(std::function<bool()> check);
+    bool wasAborted() const;
+
+    qint64 getNodeCount() const;
+    qint64 getBacktrackCount() const;
+    int getDepth() const;
+
+private:
+    // node links, nodes 0..COLUMNS-1 are column headers, COLUMNS is the root
+    std::vector<int> left, right, up, down, column;
+    std::vector<int> row_of;     // matrix row of every node
+    std::vector<int> row_start;  // first node of every matrix row
+    std::vector<int> size;       // number of nodes in every column
+    std::vector<int> chosen;     // matrix rows selected at every search depth
+    std::function<bool()> abort_check;
+    bool aborted;
+    qint64 nodes;
+    qint64 backtracks;
+    int depth;
+    int found;
+    val* solution_out;
+    const val* puzzle_in;
+
+    void build();
+    void cover(int c);
+    void uncover(int c);
+    int search(int limit);
+};
+
+typedef DlxSolverT<SUDOKU_BOX_SIZE> DlxSolver;
+
+#endif // DLXSOLVER_H
@@ -0,0 +1,211 @@
+#include "sudokubatch.h"
+#include <QThread>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// range of task indices [begin,end) owned by one worker
+// the owner takes tasks from the front, thieves take the back half
+typedef struct {
+    std::mutex lock;
+    qint64 begin;
+    qint64 end;
+} WORK_RANGE;
+
+// per worker counters, kept on the worker's stack while it runs and summed up after the run
+typedef struct {
+    qint64 solved;
+    qint64 guesses;
+    qint64 backtracks;
+    qint64 steals;
+    SOLVE_STATS stats;
+} WORKER_TOTALS;
+
+// constructor, 'threads' 0 uses all cores
+template<int BOX_SIZE>
+SudokuBatchT<BOX_SIZE>::SudokuBatchT(int threads) :
+    thread_count(threads > 0 ? threads : qMax(1, QThread::idealThreadCount())),
+    engine(ENGINE_DEDUCTION),
+    solve_cache(nullptr)
+{
+}
+
+// function to select the solver engine of the boards owned by the worker threads
+template<int BOX_SIZE>
+void SudokuBatchT<BOX_SIZE>::setEngine(SOLVER_ENGINE e)
+{
+    engine = e;
+}
+
+// function to share a solve cache between the boards of all worker threads, nullptr (default) turns it off
+template<int BOX_SIZE>
+void SudokuBatchT<BOX_SIZE>::setSolveCache(SudokuSolveCache* cache)
+{
+    solve_cache = cache;
+}
+
+// function to return the number of worker threads
+template<int BOX_SIZE>
+int SudokuBatchT<BOX_SIZE>::getThreadCount() const
+{
+    return thread_count;
+}
+
+// function to take the next task of the worker 'w', returns -1 if its range is empty
+static qint64 takeTask(WORK_RANGE& w)
+{
+    std::lock_guard<std::mutex> guard(w.lock);
+    if(w.begin < w.end){
+        return w.begin++;
+    }
+    return -1;
+}
+
+// function to move the back half of the largest range of the other workers to the worker 'self'
+// returns false when there is nothing left to steal
+static bool stealTasks(QVector<WORK_RANGE*>& ranges, int self)
+{
+    while(true){
+        // pick the victim with the most remaining work
+        int victim = -1;
+        qint64 most = 0;
+        for(int i=0; i<ranges.count(); i++){
+            if(i == self){
+                continue;
+            }
+            qint64 left;
+            {
+                std::lock_guard<std::mutex> guard(ranges[i]->lock);
+                left = ranges[i]->end - ranges[i]->begin;
+            }
+            if(left > most){
+                most = left;
+                victim = i;
+            }
+        }
+        if(victim == -1){
+            return false;
+        }
+
+        qint64 begin, end;
+        {
+            std::lock_guard<std::mutex> guard(ranges[victim]->lock);
+            qint64 left = ranges[victim]->end - ranges[victim]->begin;
+            if(left <= 0){
+                continue; // the victim finished meanwhile, look again
+            }
+            end = ranges[victim]->end;
+            begin = end - (left+1)/2;
+            ranges[victim]->end = begin;
+        }
+        std::lock_guard<std::mutex> guard(ranges[self]->lock);
+        ranges[self]->begin = begin;
+        ranges[self]->end = end;
+        return true;
+    }
+}
+
+// function to run 'count' tasks on all worker threads and wait for them
+template<int BOX_SIZE>
+BATCH_REPORT SudokuBatchT<BOX_SIZE>::run(qint64 count, BATCH_TASK task)
+{
+    BATCH_REPORT report = {};
+    report.tasks = count;
+    report.threads = thread_count;
+
+    // latency of every task, each slot is written by exactly one thread
+    std::vector<qint64> latencies(size_t(qMax<qint64>(count, 0)), 0);
+
+    // split the tasks evenly between the workers
+    QVector<WORK_RANGE*> ranges;
+    QVector<WORKER_TOTALS> totals(thread_count, WORKER_TOTALS());
+    for(int i=0; i<thread_count; i++){
+        WORK_RANGE* r = new WORK_RANGE;
+        r->begin = count*i/thread_count;
+        r->end = count*(i+1)/thread_count;
+        ranges.push_back(r);
+    }
+
+    QElapsedTimer total_timer;
+    total_timer.start();
+
+    std::vector<std::thread> workers;
+    for(int i=0; i<thread_count; i++){
+        workers.emplace_back([&, i](){
+            SudokuBoardT<BOX_SIZE> board;
+            board.setEngine(engine);
+            board.setSolveCache(solve_cache);
+            QElapsedTimer timer;
+            WORKER_TOTALS t = {};
+            while(true){
+                qint64 index = takeTask(*ranges[i]);
+                if(index < 0){
+                    if(!stealTasks(ranges, i)){
+                        break;
+                    }
+                    t.steals++;
+                    continue;
+                }
+                timer.start();
+                if(task(index, board)){
+                    t.solved++;
+                }
+                latencies[size_t(index)] = timer.nsecsElapsed();
+                t.guesses += board.getGuessCount();
+                t.backtracks += board.getBacktrackCount();
+                addSolveStats(t.stats, board.getStats());
+            }
+            totals[i] = t;
+        });
+    }
+    for(std::thread& w : workers){
+        w.join();
+    }
+
+    report.total_seconds = total_timer.nsecsElapsed()/1e9;
+    for(int i=0; i<thread_count; i++){
+        report.solved += totals[i].solved;
+        report.guesses += totals[i].guesses;
+        report.backtracks += totals[i].backtracks;
+        report.steals += totals[i].steals;
+        addSolveStats(report.stats, totals[i].stats);
+        delete ranges[i];
+    }
+    report.tasks_per_second = report.total_seconds > 0 ? count/report.total_seconds : 0;
+
+    if(count > 0){
+        std::sort(latencies.begin(), latencies.end());
+        report.min_ms = latencies.front()/1e6;
+        report.median_ms = latencies[size_t(count/2)]/1e6;
+        report.p99_ms = latencies[size_t(qMin(count-1, count*99/100))]/1e6;
+        report.max_ms = latencies.back()/1e6;
+    }
+    return report;
+}
+
+// function to format the report as text
+template<int BOX_SIZE>
+QString SudokuBatchT<BOX_SIZE>::formatReport(const BATCH_REPORT& report)
+{
+    return "Puzzles: " + QString::number(report.tasks) + " (" + QString::number(report.solved) + " solved)" +
+           ", threads: " + QString::number(report.threads) + "\n" +
+           "Total time: " + QString::number(report.total_seconds,'f',3) + " s" +
+           ", puzzles/s: " + QString::number(report.tasks_per_second,'f',1) + "\n" +
+           "Latency [ms] min: " + QString::number(report.min_ms,'f',3) +
+           ", median: " + QString::number(report.median_ms,'f',3) +
+           ", p99: " + QString::number(report.p99_ms,'f',3) +
+           ", max: " + QString::number(report.max_ms,'f',3) + "\n" +
+           "Guesses: " + QString::number(report.guesses) +
+           ", backtracks: " + QString::number(report.backtracks) +
+           ", backtracks/s: " + QString::number(report.total_seconds > 0 ? report.backtracks/report.total_seconds : 0.0,'f',0) +
+           ", steals: " + QString::number(report.steals) + "\n" +
+           SudokuBoardT<BOX_SIZE>::formatStats(report.stats);
+}
+
+// the batch is compiled for these box sizes only
+template class SudokuBatchT<3>;
+template class SudokuBatchT<4>;
+template class SudokuBatchT<5>;
@@ -0,0 +1,54 @@
+#ifndef SUDOKUBATCH_H
+#define SUDOKUBATCH_H
+
+#include "sudokuboard.h"
+#include <QVector>
+#include <QString>
+#include <functional>
+
+// aggregate report of a batch run, latencies are per task in milliseconds
+typedef struct {
+    qint64 tasks;
+    qint64 solved;
+    int threads;
+    double total_seconds;
+    double tasks_per_second;
+    double min_ms;
+    double median_ms;
+    double p99_ms;
+    double max_ms;
+    qint64 guesses;
+    qint64 backtracks;
+    qint64 steals; // how many times an idle thread took work from another thread
+    SOLVE_STATS stats; // solver counters summed over all tasks
+} BATCH_REPORT;
+
+// runs batch tasks on all cores
+// every thread owns a board and a range of task indices, a thread that runs out
+// of work steals the back half of the largest remaining range of another thread
+template<int BOX_SIZE>
+class SudokuBatchT
+{
+public:
+    // one batch task, called on a worker thread with the index of the task and
+    // the board owned by that thread, returns true if the puzzle was solved
+    typedef std::function<bool(qint64 index, SudokuBoardT<BOX_SIZE>& board)> BATCH_TASK;
+
+    SudokuBatchT(int threads = 0);
+
+    int getThreadCount() const;
+    void setEngine(SOLVER_ENGINE engine);
+    void setSolveCache(SudokuSolveCache* cache);
+    BATCH_REPORT run(qint64 count, BATCH_TASK task);
+    static QString formatReport(const BATCH_REPORT& report);
+
+private:
+    int thread_count;
+    SOLVER_ENGINE engine;
+    SudokuSolveCache* solve_cache;
+};
+
+typedef SudokuBatchT<SUDOKU_BOX_SIZE> SudokuBatch;
+typedef SudokuBatch::BATCH_TASK BATCH_TASK;
+
+#endif // SUDOKUBATCH_H
@@ -0,0 +1,2425 @@
+#include "sudokuboard.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+// logs 'message' (and optionally its MESSAGE_TYPE) at 'level', usable in SudokuBoardT members only
+// nothing is compiled in for levels above SUDOKU_LOG_LEVEL, and the message is built only when a handler is installed
+#define SUDOKU_LOG(level, ...) \
+    do{ if((level) <= SUDOKU_LOG_LEVEL && message_handler){ logMessage(__VA_ARGS__); } }while(0)
+
+// function to return the next set of the same number of bits in increasing order (Gosper's hack),
+// used to visit every selection of k members out of n
+static quint32 nextSelection(quint32 selection)
+{
+    quint32 lowest = selection & (~selection+1);
+    quint32 ripple = selection+lowest;
+    return (((ripple ^ selection) >> 2)/lowest) | ripple;
+}
+
+// Sudoku Explainer ratings of the elimination techniques, in ELIMINATION_TECHNIQUE order
+static const double technique_rating[TECHNIQUE_COUNT] = {2.6, 3.0, 3.4, 3.2, 3.6, 4.0, 3.8, 5.0, 5.4, 5.2};
+static const char* const technique_name[TECHNIQUE_COUNT] = {
+    "locked candidates", "naked pair", "hidden pair", "x-wing", "naked triple",
+    "hidden triple", "swordfish", "naked quad", "hidden quad", "jellyfish"
+};
+// elimination techniques in the order of their ratings, easiest first
+static const ELIMINATION_TECHNIQUE rating_order[TECHNIQUE_COUNT] = {
+    TECHNIQUE_LOCKED_CANDIDATES, TECHNIQUE_NAKED_PAIR, TECHNIQUE_X_WING, TECHNIQUE_HIDDEN_PAIR, TECHNIQUE_NAKED_TRIPLE,
+    TECHNIQUE_SWORDFISH, TECHNIQUE_HIDDEN_TRIPLE, TECHNIQUE_NAKED_QUAD, TECHNIQUE_JELLYFISH, TECHNIQUE_HIDDEN_QUAD
+};
+
+// constructor that creates empty Sudoku board of size SIDE x SIDE
+template<int BOX_SIZE>
+SudokuBoardT<BOX_SIZE>::SudokuBoardT() :
+    engine(ENGINE_DEDUCTION),
+    backtracking_mode(BACKTRACK_TRAIL),
+    max_subset_size(MAX_SUBSET_SIZE),
+    random(std::random_device()()),
+    generator_mode(GENERATE_BACKTRACKING),
+    seed_grid_uses(0),
+    guess_count(0),
+    backtrack_count(0),
+    stats(),
+    solve_cache(nullptr),
+    trace_enabled(false),
+    progress_interval_ms(100),
+    cancelled(false)
+{
+    // set size of the board and assign coordinates to each cell
+    board.resize(SIDE);
+    int rowi = 0;
+    int coli = 0;
+    for(auto& row : board){
+        row.resize(SIDE);
+        for(CELL_INFO& cell : row){
+            cell.coord = QPoint(rowi,coli);
+
+            coli++;
+        }
+        coli = 0;
+        rowi++;
+    }
+
+    // set size of the auxiliary matrix with candidate information
+    candidate_info.resize(SIDE);
+    for(auto& row : candidate_info){
+        row.fill(NO_CANDIDATES,SIDE);
+    }
+
+    // set size of the global auxiliary matrix with candidate information
+    global_candidate_info.resize(SIDE);
+    for(auto& row : global_candidate_info){
+        row.fill(NO_CANDIDATES,SIDE);
+    }
+
+    // reset the board
+    reset();
+}
+
+// function to generate solved Sudoku board (fill it with valid numbers) and reveal clues
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::generate()
+{
+    if(board.isEmpty()){
+        SUDOKU_LOG(SUDOKU_LOG_INFO, "Board has no dimensions.");
+        return;
+    }
+    reset();
+    val grid[CELLS];
+    generateGrid(grid);
+    for(int i=0; i<CELLS; i++){
+        board[i/SIDE][i%SIDE].value = grid[i];
+        board[i/SIDE][i%SIDE].candidates = NO_CANDIDATES;
+    }
+    showClues();
+    originalBoard = board;
+    SUDOKU_LOG(SUDOKU_LOG_RESULT, "RANDOM SUDOKU GENERATED "+QDateTime::currentDateTime().toString(QString("dd.MM.yyyy,hh:mm:ss")),MESSAGE_GENERATED);
+}
+
+// function to generate the board from the random sequence of 'seed', the same seed gives the same board
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::generate(quint64 seed)
+{
+    setSeed(seed);
+    generate();
+}
+
+// function to generate new Sudoku board with exactly one solution
+// starting from a random solved board, clues are removed in random order and a removal is undone
+// whenever the puzzle stops being unique, so the result is also minimal (no clue can be removed)
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::generateUnique()
+{
+    if(board.isEmpty()){
+        SUDOKU_LOG(SUDOKU_LOG_INFO, "Board has no dimensions.");
+        return;
+    }
+    reset();
+
+    val solution[CELLS];
+    val puzzle[CELLS];
+    int order[CELLS];
+    generateGrid(solution);
+    for(int i=0; i<CELLS; i++){
+        puzzle[i] = solution[i];
+        order[i] = i;
+    }
+    random.shuffle(order, CELLS);
+    for(int i=0; i<CELLS; i++){
+        int c = order[i];
+        puzzle[c] = 0;
+        if(countPuzzleSolutions(puzzle, 2) != 1){
+            puzzle[c] = solution[c];
+        }
+    }
+
+    for(int i=0; i<CELLS; i++){
+        CELL_INFO& cell = board[i/SIDE][i%SIDE];
+        cell.value = puzzle[i];
+        cell.revealed = puzzle[i] != 0;
+        cell.candidates = NO_CANDIDATES;
+    }
+    updateCandidates();
+    originalBoard = board;
+    SUDOKU_LOG(SUDOKU_LOG_RESULT, "UNIQUE SUDOKU GENERATED "+QDateTime::currentDateTime().toString(QString("dd.MM.yyyy,hh:mm:ss")),MESSAGE_GENERATED);
+}
+
+// function to generate the unique puzzle from the random sequence of 'seed'
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::generateUnique(quint64 seed)
+{
+    setSeed(seed);
+    generateUnique();
+}
+
+// function to count the solutions of the revealed cells, counting stops after 'limit' solutions
+// 0 means an invalid or unsolvable board, 1 a proper puzzle; the board itself is not changed
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::countSolutions(int limit)
+{
+    val puzzle[CELLS];
+    writeValues(puzzle);
+    return countPuzzleSolutions(puzzle, limit);
+}
+
+// function to restart the random sequence of the generator, a new seed grid is made on the next permutation
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setSeed(quint64 seed)
+{
+    random.setSeed(seed);
+    seed_grid_uses = 0;
+}
+
+// function to select how generate() fills the solved grid
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setGeneratorMode(GENERATOR_MODE mode)
+{
+    generator_mode = mode;
+    seed_grid_uses = 0;
+}
+
+// function to return how generate() fills the solved grid
+template<int BOX_SIZE>
+GENERATOR_MODE SudokuBoardT<BOX_SIZE>::getGeneratorMode() const
+{
+    return generator_mode;
+}
+
+// function to fill 'grid' with CELLS values of a random solved board, the board itself is not changed
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::generateGrid(val* grid)
+{
+    if(generator_mode == GENERATE_PERMUTATION){
+        if(seed_grid_uses == 0){
+            fillGrid(seed_grid);
+        }
+        seed_grid_uses = (seed_grid_uses+1)%SEED_GRID_REUSE;
+        permuteGrid(seed_grid, grid);
+    }
+    else{
+        fillGrid(grid);
+    }
+}
+
+// function to fill 'grid' with a random solved board by backtracking
+// the random cell by cell fill gets lost in dead ends on boards larger than 9x9,
+// these fill the boxes on the diagonal at random (they share no unit, so any fill is valid)
+// and complete the grid with the dancing links engine instead
+// a few random boxes send the completion into a long search, these are dropped after FILL_GRID_NODE_LIMIT nodes
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::fillGrid(val* grid)
+{
+    if(BOX_SIZE == SUDOKU_BOX_SIZE){
+        cmask used[UNITS] = {};
+        fillCells(grid, 0, used);
+        return;
+    }
+    dlx.setAbortCheck([this](){ return dlx.getNodeCount() > FILL_GRID_NODE_LIMIT; });
+    val puzzle[CELLS];
+    do{
+        memset(puzzle, 0, sizeof(puzzle));
+        for(int b=0; b<BOX; b++){
+            val digits[SIDE];
+            for(int i=0; i<SIDE; i++){
+                digits[i] = val(i+1);
+            }
+            random.shuffle(digits, SIDE);
+            for(int i=0; i<SIDE; i++){
+                puzzle[(b*BOX + i/BOX)*SIDE + b*BOX + i%BOX] = digits[i];
+            }
+        }
+    } while(dlx.solve(puzzle, grid) == 0);
+    dlx.setAbortCheck(nullptr);
+}
+
+// recursive function to fill the cells of 'grid' from 'index' on with random values
+// 'used' holds the values already placed in every unit (rows, then columns and boxes)
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::fillCells(val* grid, int index, cmask* used)
+{
+    if(index == CELLS){
+        return true;
+    }
+    int row = index/SIDE;
+    int col = index%SIDE;
+    int box = (row/BOX)*BOX + col/BOX;
+    cmask valid_options = ALL_CANDIDATES & ~(used[row] | used[SIDE+col] | used[2*SIDE+box]);
+    val v_options[SIDE];
+    int options_count = 0;
+    for(cmask m = valid_options; m; m &= m-1){
+        v_options[options_count++] = firstCandidate(m);
+    }
+    random.shuffle(v_options, options_count);
+    for(int i = 0; i < options_count; i++) {
+        cmask bit = valueBit(v_options[i]);
+        grid[index] = v_options[i];
+        used[row] |= bit;
+        used[SIDE+col] |= bit;
+        used[2*SIDE+box] |= bit;
+        if(fillCells(grid, index+1, used)){
+            return true;
+        }
+        // no value fits a later cell, try the next option
+        used[row] &= ~bit;
+        used[SIDE+col] &= ~bit;
+        used[2*SIDE+box] &= ~bit;
+    }
+    grid[index] = 0;
+    return false;
+}
+
+// function to write a random grid equivalent to 'seed' to 'grid': the values are relabeled, rows are
+// shuffled within their bands, bands are shuffled, the same is done for columns and stacks,
+// and the grid is transposed in half of the cases; all of these keep the grid valid
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::permuteGrid(const val* seed, val* grid)
+{
+    val digits[SIDE+1];
+    int bands[BOX], stacks[BOX], rows[SIDE], cols[SIDE];
+    digits[0] = 0;
+    for(int i=0; i<SIDE; i++){
+        digits[i+1] = val(i+1);
+    }
+    random.shuffle(digits+1, SIDE);
+    for(int i=0; i<BOX; i++){
+        bands[i] = i;
+        stacks[i] = i;
+    }
+    random.shuffle(bands, BOX);
+    random.shuffle(stacks, BOX);
+    for(int b=0; b<BOX; b++){
+        int band_rows[BOX], stack_cols[BOX];
+        for(int i=0; i<BOX; i++){
+            band_rows[i] = bands[b]*BOX+i;
+            stack_cols[i] = stacks[b]*BOX+i;
+        }
+        random.shuffle(band_rows, BOX);
+        random.shuffle(stack_cols, BOX);
+        for(int i=0; i<BOX; i++){
+            rows[b*BOX+i] = band_rows[i];
+            cols[b*BOX+i] = stack_cols[i];
+        }
+    }
+
+    bool transpose = random.next() & 1;
+    for(int r=0; r<SIDE; r++){
+        for(int c=0; c<SIDE; c++){
+            int from = transpose ? cols[c]*SIDE+rows[r] : rows[r]*SIDE+cols[c];
+            grid[r*SIDE+c] = digits[seed[from]];
+        }
+    }
+}
+
+// function to reveal clues on Sudoku board, requires already generated Sudoku board
+// what really happens here is that some cells are set as revealed
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::showClues()
+{
+    int rand_indices[CELLS];
+    std::iota(rand_indices, rand_indices+CELLS, 0);
+    random.shuffle(rand_indices, CELLS);
+    // the same share of clues as CLUES_COUNT on 9x9 boards
+    int clues = CLUES_COUNT*CELLS/CELL_COUNT;
+    int c;
+    for (int i = 0; i<clues;i++) {
+        c = rand_indices[i];
+        board[c/SIDE][c%SIDE].revealed = true;
+        board[c/SIDE][c%SIDE].candidates = NO_CANDIDATES;
+    }
+    updateCandidates();
+    // the rest of the board is set to 0
+    for (int i = clues; i<SIDE*SIDE;i++) {
+        c = rand_indices[i];
+        board[c/SIDE][c%SIDE].value = 0;
+    }
+}
+
+// function to reset the contents of Sudoku board to 0, set default candidates and set cell revelation status to false
+// function also resets candidate board to unguessed status and the counters of the last solve,
+// so a board loaded and not solved reports no guesses, backtracks or stats
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::reset()
+{
+    // reset Sudoku board
+    for(auto& row : board){
+        for(CELL_INFO& cell : row){
+            cell.value = 0;
+            cell.candidates = ALL_CANDIDATES;
+            cell.revealed = false;
+        }
+    }
+
+    // reset candidate info - guess status
+    for(auto& row : candidate_info){
+        row.fill(NO_CANDIDATES);
+    }
+
+    // reset global candidate info
+    for(auto& row : global_candidate_info){
+        row.fill(NO_CANDIDATES);
+    }
+    history.clear();
+    trail.clear();
+    trail_marks.clear();
+    guess_count = 0;
+    backtrack_count = 0;
+    stats = SOLVE_STATS();
+}
+
+// function to load a puzzle from CELLS values, row by row, 0 for empty cells
+// returns false if the values are not a valid puzzle (value above SIDE or conflicting clues)
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::loadValues(const val* values)
+{
+    reset();
+    for(int i=0; i<CELLS; i++){
+        val v = values[i];
+        if(v > SIDE){
+            reset();
+            return false;
+        }
+        if(v){
+            CELL_INFO& cell = board[i/SIDE][i%SIDE];
+            cell.value = v;
+            cell.revealed = true;
+            cell.candidates = NO_CANDIDATES;
+        }
+    }
+    updateCandidates();
+    originalBoard = board;
+    QString whatHappened;
+    return isGood(whatHappened);
+}
+
+// function to copy the revealed values to 'values', CELLS values with 0 for unrevealed cells
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::writeValues(val* values) const
+{
+    for(int i=0; i<CELLS; i++){
+        const CELL_INFO& cell = board[i/SIDE][i%SIDE];
+        values[i] = cell.revealed ? cell.value : 0;
+    }
+}
+
+// function to load a puzzle from the text of CELLS characters, row by row
+// clues are written as in valueFromChar ('1'-'9', then 'A' for 10...), '0' or '.' are empty cells
+// returns false if the text is not a valid puzzle (unknown character or conflicting clues)
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::loadString(const char* text)
+{
+    val values[CELLS];
+    if(!decodeStrings(text, 1, values)){
+        reset();
+        return false;
+    }
+    return loadValues(values);
+}
+
+// function to write the board as CELLS characters, row by row, unrevealed cells are written as '.'
+// 'text' must have room for CELLS characters, no terminating zero is written
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::writeString(char* text) const
+{
+    val values[CELLS];
+    writeValues(values);
+    encodeStrings(values, 1, text);
+}
+
+// function to load a puzzle from its PACKED_SIZE bytes, returns false if it is not a valid puzzle
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::loadPacked(const uchar* packed)
+{
+    val values[CELLS];
+    unpackBoards(packed, 1, values);
+    return loadValues(values);
+}
+
+// function to write the revealed values as PACKED_SIZE bytes
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::writePacked(uchar* packed) const
+{
+    val values[CELLS];
+    writeValues(values);
+    packBoards(values, 1, packed);
+}
+
+// function to load a puzzle from the given mask and digits form, the size of the form is returned in 'size'
+// returns false if it is not a valid puzzle
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::loadGivens(const uchar* givens, int* size)
+{
+    val values[CELLS];
+    qint64 n = decodeGivens(givens, 1, values);
+    if(size){
+        *size = int(n);
+    }
+    return loadValues(values);
+}
+
+// function to write the revealed values in the given mask and digits form, returns its size in bytes
+// 'givens' must have room for GIVENS_MAX_SIZE bytes
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::writeGivens(uchar* givens) const
+{
+    val values[CELLS];
+    writeValues(values);
+    return int(encodeGivens(values, 1, givens));
+}
+
+// function to write 'bits' low bits of 'value' at bit 'pos' of a little-endian bit stream
+// the bits must be zero before, a value is at most 8 bits and spans two bytes at most
+static inline void putBits(uchar* stream, qint64 pos, unsigned value, int bits)
+{
+    int shift = int(pos & 7);
+    stream[pos >> 3] |= uchar(value << shift);
+    if(shift+bits > 8){
+        stream[(pos >> 3)+1] |= uchar(value >> (8-shift));
+    }
+}
+
+// function to read 'bits' bits at bit 'pos' of a little-endian bit stream
+static inline unsigned getBits(const uchar* stream, qint64 pos, int bits)
+{
+    int shift = int(pos & 7);
+    unsigned value = unsigned(stream[pos >> 3]) >> shift;
+    if(shift+bits > 8){
+        value |= unsigned(stream[(pos >> 3)+1]) << (8-shift);
+    }
+    return value & ((1u << bits)-1);
+}
+
+// value of every character as in valueFromChar(), looked up while decoding strings
+static const struct CHAR_VALUES {
+    signed char values[256];
+    CHAR_VALUES(){
+        for(int c=0; c<256; c++){
+            values[c] = (signed char)valueFromChar(char(c));
+        }
+    }
+} char_values;
+
+// function to convert 'count' boards of CELLS characters each to values
+// returns false at the first character that is not a value of the board, the boards before it are converted
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::decodeStrings(const char* text, qint64 count, val* values)
+{
+    for(qint64 i=0; i<count*CELLS; i++){
+        int v = char_values.values[uchar(text[i])];
+        if(v < 0 || v > SIDE){
+            return false;
+        }
+        values[i] = val(v);
+    }
+    return true;
+}
+
+// function to convert 'count' boards of CELLS values each to characters, '.' for empty cells, no terminating zeros
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::encodeStrings(const val* values, qint64 count, char* text)
+{
+    // characters of the values 0..31 as in charFromValue()
+    static const char value_chars[] = ".123456789ABCDEFGHIJKLMNOPQRSTUV";
+    for(qint64 i=0; i<count*CELLS; i++){
+        val v = values[i];
+        text[i] = v < 32 ? value_chars[v] : charFromValue(v);
+    }
+}
+
+// function to pack 'count' boards of CELLS values each into PACKED_SIZE bytes per board
+// cell i is stored in VALUE_BITS bits at bit i*VALUE_BITS, so a 9x9 board has two cells per byte, the even cell low
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::packBoards(const val* values, qint64 count, uchar* packed)
+{
+    for(qint64 b=0; b<count; b++, values+=CELLS, packed+=PACKED_SIZE){
+        if(VALUE_BITS == 4){
+            for(int i=0; i<CELLS/2; i++){
+                packed[i] = uchar(values[2*i] | values[2*i+1] << 4);
+            }
+            if(CELLS%2){
+                packed[CELLS/2] = values[CELLS-1];
+            }
+            continue;
+        }
+        memset(packed, 0, PACKED_SIZE);
+        for(int i=0; i<CELLS; i++){
+            putBits(packed, qint64(i)*VALUE_BITS, values[i], VALUE_BITS);
+        }
+    }
+}
+
+// function to unpack 'count' boards of PACKED_SIZE bytes each into CELLS values per board
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::unpackBoards(const uchar* packed, qint64 count, val* values)
+{
+    for(qint64 b=0; b<count; b++, values+=CELLS, packed+=PACKED_SIZE){
+        if(VALUE_BITS == 4){
+            for(int i=0; i<CELLS/2; i++){
+                values[2*i] = val(packed[i] & 0x0F);
+                values[2*i+1] = val(packed[i] >> 4);
+            }
+            if(CELLS%2){
+                values[CELLS-1] = val(packed[CELLS/2] & 0x0F);
+            }
+            continue;
+        }
+        for(int i=0; i<CELLS; i++){
+            values[i] = val(getBits(packed, qint64(i)*VALUE_BITS, VALUE_BITS));
+        }
+    }
+}
+
+// function to encode 'count' boards of CELLS values each in the given mask and digits form, returns the bytes written
+// a board is a mask of CELLS bits, bit i set when cell i is given, followed by DIGIT_BITS bits per given cell
+// holding its value-1 in cell order, padded to whole bytes: 17 clues of a 9x9 board take 19 bytes
+// 'givens' must have room for GIVENS_MAX_SIZE bytes per board
+template<int BOX_SIZE>
+qint64 SudokuBoardT<BOX_SIZE>::encodeGivens(const val* values, qint64 count, uchar* givens)
+{
+    qint64 written = 0;
+    for(qint64 b=0; b<count; b++, values+=CELLS){
+        uchar* out = givens+written;
+        memset(out, 0, GIVENS_MAX_SIZE);
+        qint64 pos = CELLS;
+        for(int i=0; i<CELLS; i++){
+            if(values[i]){
+                out[i >> 3] |= uchar(1 << (i & 7));
+                putBits(out, pos, values[i]-1u, DIGIT_BITS);
+                pos += DIGIT_BITS;
+            }
+        }
+        written += (pos+7)/8;
+    }
+    return written;
+}
+
+// function to decode 'count' boards in the given mask and digits form into CELLS values each, returns the bytes read
+template<int BOX_SIZE>
+qint64 SudokuBoardT<BOX_SIZE>::decodeGivens(const uchar* givens, qint64 count, val* values)
+{
+    qint64 read = 0;
+    for(qint64 b=0; b<count; b++, values+=CELLS){
+        const uchar* in = givens+read;
+        qint64 pos = CELLS;
+        for(int i=0; i<CELLS; i++){
+            if(in[i >> 3] & (1 << (i & 7))){
+                values[i] = val(getBits(in, pos, DIGIT_BITS)+1);
+                pos += DIGIT_BITS;
+            }
+            else{
+                values[i] = 0;
+            }
+        }
+        read += (pos+7)/8;
+    }
+    return read;
+}
+
+// function to display current Sudoku board
+// * detailed false - only revealed values
+// * detailed true - complete information for each cell
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::print(bool detailed)
+{
+    QString buffer;
+    QTextStream message(&buffer);
+    int cnt=0;
+    int cnt2=0;
+    QString hline = " -------------------- ";
+    QString str_row;
+    for(const auto& row: board){
+        str_row.clear();
+        if(!detailed){
+            if(cnt%BOX == 0){
+                message << hline << "\n";
+            }
+            cnt++;
+            cnt2=0;
+        }
+
+        for(const CELL_INFO& cell: row){
+            if(!detailed){
+                if(cnt2%BOX == 0){
+                    str_row += "|";
+                }
+                cnt2++;
+            }
+
+            if(cell.revealed){
+                str_row += QString::number(cell.value);
+            }
+            else{
+                str_row+=".";
+            }
+
+            if(detailed){
+                if(cell.revealed){
+                    str_row += " (" + QString::number(cell.coord.x()) + "," + QString::number(cell.coord.y()) + ")";
+                    str_row += " [" + QString::number(cell.revealed) + "]";
+                }
+
+                if(!cell.revealed){
+                    str_row += " {";
+                    for(cmask m = cell.candidates; m; m &= m-1){
+                        str_row += QString::number(firstCandidate(m)) + " ";
+                    }
+                    str_row += "} ";
+                }
+                str_row += "|";
+
+            }
+            str_row += " ";
+
+        }
+        if(!detailed){
+            str_row +="|";
+        }
+        message << str_row << "\n";
+    }
+    if(!detailed){
+        message << hline << "\n";
+    }
+    message << "\n";
+    logMessage(message.readAll());
+}
+
+// function to display provided Sudoku board, only revealed cells
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::printBoard(const QVector<QVector<CELL_INFO> > & board)
+{
+    QString buffer;
+    QTextStream message(&buffer);
+    for(int row = 0; row<board.count(); row++){
+        if((row)%BOX == 0){
+            message << "-------------------------\n";
+        }
+        for(int col = 0; col<board[row].count(); col++){
+            if((col)%BOX==0){
+                message << "| ";
+            }
+            if( board[row][col].revealed){
+                message << board[row][col].value << " ";
+            }
+            else{
+                message << ". ";
+            }
+        }
+        message << "| ";
+        message << "\n";
+
+    }
+    message << "-------------------------\n";
+    logMessage(message.readAll());
+}
+
+// function to display which candidates of unrevealed cells have been guessed ('x' symbol)
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::printGuessedCandidates(const QVector<QVector<CELL_INFO> > & board, const QVector<QVector<cmask>>& candidate_info)
+{
+    QString buffer;
+    QTextStream message(&buffer);
+    for(int row = 0; row<candidate_info.count(); row++){
+        if((row)%BOX == 0){
+            message << "------------------------------ ------------------------------ ------------------------------\n";
+        }
+        for(int col = 0; col<candidate_info[row].count(); col++){
+            if((col)%BOX==0){
+                message << "| ";
+            }
+            if(!board[row][col].revealed){
+                for(int k =0; k<SIDE; k++){
+                    message << ((candidate_info[row][col] & valueBit(k+1))?"x":QString::number(k+1));
+                }
+            }
+            else{
+                for(int k =0; k<SIDE; k++){
+                    message << " ";
+                }
+            }
+            message << " ";
+        }
+        message << "| ";
+        message << "\n";
+
+    }
+    message << "------------------------------ ------------------------------ ------------------------------\n";
+    logMessage(message.readAll());
+}
+
+// function to check if Sudoku board is solved
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::isSolved()
+{
+    QString whatHappened;
+    QVector<CELL_INFO> unsolved;
+
+    // check if all cells are revealed
+    for(int i=0; i<board.count();i++){
+        for(int j = 0; j<board[i].count();j++){
+            if(!board[i][j].revealed){
+                unsolved.push_back(board[i][j]);
+            }
+        }
+    }
+    if(!unsolved.isEmpty()){
+        whatHappened = "board is not solved because there are some unrevealed cells in it";
+        return false;
+    }
+
+    // check if all cells contain numbers 1-SIDE
+    for(int i=0; i<board.count();i++){
+        for(int j=0;j<board[i].count();j++){
+            if(!(board[i][j].value >=1 && board[i][j].value <=SIDE)){
+                whatHappened = "invalid value: (" + QString::number(i) + "," + QString::number(j);
+                return false;
+            }
+        }
+    }
+
+    // check row conflicts
+    cmask row;
+    for(int i=0; i<board.count();i++){
+        row = NO_CANDIDATES;
+        for(int j=0;j<board[i].count();j++){
+            row |= valueBit(board[i][j].value);
+        }
+        if(row != ALL_CANDIDATES){
+            whatHappened = "row uniqueness: " + QString::number(i);
+            return false;
+        }
+    }
+
+    // check column conflicts
+    cmask col;
+    for(int i=0; i<board[0].count();i++){
+        col = NO_CANDIDATES;
+        for(int j=0;j<board.count();j++){
+            col |= valueBit(board[j][i].value);
+        }
+        if(col != ALL_CANDIDATES){
+            whatHappened = "column uniqueness: " + QString::number(i);
+            return false;
+        }
+    }
+
+    // check box conflicts
+    cmask box;
+    for(int i=0; i<SIDE;i+=BOX){
+        for(int j=0; j<SIDE;j+=BOX){
+            box = NO_CANDIDATES;
+            int box_r = floor(i/BOX)*BOX; // row index of the box top left position
+            int box_c = floor(j/BOX)*BOX; // column index of the box top left position
+            for(int box_i = box_r;box_i<box_r+BOX;box_i++){
+                for(int box_j = box_c;box_j<box_c+BOX;box_j++){
+                    box |= valueBit(board[box_i][box_j].value);
+                }
+            }
+            if(box != ALL_CANDIDATES){
+                whatHappened = "box uniqueness: (" + QString::number(i) + "," + QString::number(j);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// function to check whether the intermediate solution has no row, column and box conflicts
+// and if there are no unrevealed cells with no candidates
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::isGood(QString& whatHappened)
+{
+    whatHappened = "all OK";
+
+    // check if there are unrevealed cells with no candidates
+    QVector<CELL_INFO> vv = getUnrevealedCellsWithNCandidates(0);
+    QString buffer;
+    QTextStream message(&buffer);
+    if(!vv.isEmpty()){
+        message << "ISGOOD = FAIL: ";
+        message << "Cells with no candidate found:\n";
+        for(auto b : vv){
+            message << "* " << "(" << b.coord.x()+1 << "," << b.coord.y()+1 << ")";
+            //highlightCell(b.coord.x(),b.coord.y());
+        }
+        whatHappened = "no candidate cell found";
+        //logMessage(message.readAll());
+        return false;
+    }
+
+    // check for row conflicts
+    cmask row;
+    for(int i=0; i<board.count();i++){
+        row = NO_CANDIDATES;
+        for(int j=0;j<board[i].count();j++){
+            if(board[i][j].revealed){
+                if(row & valueBit(board[i][j].value)){
+                    whatHappened = "row uniqueness: " + QString::number(i);
+                    return false;
+                }
+                row |= valueBit(board[i][j].value);
+            }
+        }
+    }
+
+    // check for column conflicts
+    cmask col;
+    for(int i=0; i<board[0].count();i++){
+        col = NO_CANDIDATES;
+        for(int j=0;j<board.count();j++){
+            if(board[j][i].revealed){
+                if(col & valueBit(board[j][i].value)){
+                    whatHappened = "column uniqueness: " + QString::number(i);
+                    return false;
+                }
+                col |= valueBit(board[j][i].value);
+            }
+        }
+    }
+
+    // check for box conflicts
+    cmask box;
+    for(int i=0; i<SIDE;i+=BOX){
+        for(int j=0; j<SIDE;j+=BOX){
+            box = NO_CANDIDATES;
+            int box_r = floor(i/BOX)*BOX; // row index of the box top left position
+            int box_c = floor(j/BOX)*BOX; // column index of the box top left position
+            for(int box_i = box_r;box_i<box_r+BOX;box_i++){
+                for(int box_j = box_c;box_j<box_c+BOX;box_j++){
+                    if(board[box_i][box_j].revealed){
+                        if(box & valueBit(board[box_i][box_j].value)){
+                            whatHappened = "box uniqueness: (" + QString::number(box_i) + "," + QString::number(box_j) + ")";
+                            return false;
+                        }
+                        box |= valueBit(board[box_i][box_j].value);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// function to get vector of all neighbors of specific cell at coordinates (row,col)
+template<int BOX_SIZE>
+QVector<typename SudokuBoardT<BOX_SIZE>::CELL_INFO> SudokuBoardT<BOX_SIZE>::getNeighbors(int row, int col){
+    QVector<CELL_INFO> s;
+
+    // get all row neighbors
+    for(int i=0;i<board.at(row).count();i++){
+        s.push_back(board.at(row).at(i));
+    }
+    // get all column neighbors
+    for(int i=0;i<board.count();i++){
+        s.push_back(board.at(i).at(col));
+    }
+    // get all box neighbors
+    int box_r = floor(row/BOX)*BOX; // row index of the box top left position
+    int box_c = floor(col/BOX)*BOX; // column index of the box top left position
+    for(int i=box_r; i<box_r+BOX;i++){
+        for(int j=box_c;j<box_c+BOX;j++){
+            s.push_back(board.at(i).at(j));
+        }
+    }
+    return s;
+}
+
+// function to obtain all unique non-zero neighbor values as a mask
+template<int BOX_SIZE>
+typename SudokuBoardT<BOX_SIZE>::cmask SudokuBoardT<BOX_SIZE>::getUniqueNeighborValues(int row, int col) const
+{
+    cmask cellNeighborsMask = NO_CANDIDATES;
+    int box_r = (row/BOX)*BOX; // row index of the box top left position
+    int box_c = (col/BOX)*BOX; // column index of the box top left position
+    for(int i=0;i<SIDE;i++){
+        if(board[row][i].value){
+            cellNeighborsMask |= valueBit(board[row][i].value);
+        }
+        if(board[i][col].value){
+            cellNeighborsMask |= valueBit(board[i][col].value);
+        }
+        const CELL_INFO& b = board[box_r+i/BOX][box_c+i%BOX];
+        if(b.value){
+            cellNeighborsMask |= valueBit(b.value);
+        }
+    }
+    return cellNeighborsMask;
+}
+
+// function to return candidates of the cell (row,col)
+template<int BOX_SIZE>
+typename SudokuBoardT<BOX_SIZE>::cmask SudokuBoardT<BOX_SIZE>::getCandidates(int row, int col) const
+{
+    return board[row][col].candidates;
+}
+
+// function to return reference to Sudoku board
+template<int BOX_SIZE>
+const QVector<QVector<typename SudokuBoardT<BOX_SIZE>::CELL_INFO> > &SudokuBoardT<BOX_SIZE>::getBoard() const
+{
+    return board;
+}
+
+// function to obtain all unrevealed cells with specific number of candidates
+template<int BOX_SIZE>
+QVector<typename SudokuBoardT<BOX_SIZE>::CELL_INFO> SudokuBoardT<BOX_SIZE>::getUnrevealedCellsWithNCandidates(int n)
+{
+    QVector<CELL_INFO> v;
+    for(int i =0; i<board.count();i++){
+        for(int j =0; j< board[i].count();j++){
+            if(!board[i][j].revealed && candidateCount(board[i][j].candidates)==n){
+                v.push_back(board[i][j]);
+            }
+        }
+    }
+    return v;
+}
+
+// function to return the number of unrevealed cells
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::getNumberOfUnrevealedCells()
+{
+    int n=0;
+    for(int i =0; i<board.count();i++){
+        for(int j =0; j< board[i].count();j++){
+            if(!board[i][j].revealed ){
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+// function that sends text message to UI
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::logMessage(QString message, MESSAGE_TYPE type)
+{
+    if(message_handler){
+        message_handler(message,type);
+    }
+}
+
+// function to set the receiver of text messages
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setMessageHandler(MESSAGE_HANDLER handler)
+{
+    message_handler = handler;
+}
+
+// function to set the receiver of solving progress, called at most once per 'interval_ms' milliseconds
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setProgressHandler(PROGRESS_HANDLER handler, int interval_ms)
+{
+    progress_handler = handler;
+    progress_interval_ms = interval_ms;
+}
+
+// function to obtain mask of cell (row,col) candidates
+template<int BOX_SIZE>
+typename SudokuBoardT<BOX_SIZE>::cmask SudokuBoardT<BOX_SIZE>::computeCandidates(int row, int col) const
+{
+    cmask revealedNeighbors = NO_CANDIDATES;
+    int box_r = (row/BOX)*BOX; // row index of the box top left position
+    int box_c = (col/BOX)*BOX; // column index of the box top left position
+    for(int i=0;i<SIDE;i++){
+        if(board[row][i].revealed){
+            revealedNeighbors |= valueBit(board[row][i].value);
+        }
+        if(board[i][col].revealed){
+            revealedNeighbors |= valueBit(board[i][col].value);
+        }
+        const CELL_INFO& b = board[box_r+i/BOX][box_c+i%BOX];
+        if(b.revealed){
+            revealedNeighbors |= valueBit(b.value);
+        }
+    }
+    return ALL_CANDIDATES & ~revealedNeighbors;
+}
+
+// function to update candidates for unrevealed cells
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::updateCandidates()
+{
+    for(int i=0;i<board.count();i++){
+        for(int j =0; j<board[i].count();j++){
+            if(!board[i][j].revealed){
+                board[i][j].candidates = computeCandidates(i,j);
+            }
+        }
+    }
+}
+
+// function to return the table of peers (row, column and box neighbors without the cell itself)
+// of every cell, the table is built only once
+template<int BOX_SIZE>
+const typename SudokuBoardT<BOX_SIZE>::PEER_TABLE& SudokuBoardT<BOX_SIZE>::peers()
+{
+    static const PEER_TABLE table = []{
+        PEER_TABLE t;
+        for(int row=0; row<SIDE; row++){
+            for(int col=0; col<SIDE; col++){
+                int n = 0;
+                int* cell_peers = t.cells[row*SIDE+col];
+                int box_r = (row/BOX)*BOX; // row index of the box top left position
+                int box_c = (col/BOX)*BOX; // column index of the box top left position
+                for(int i=0; i<SIDE; i++){
+                    if(i != col){
+                        cell_peers[n++] = row*SIDE+i;
+                    }
+                    if(i != row){
+                        cell_peers[n++] = i*SIDE+col;
+                    }
+                }
+                // box cells outside the cell row and column
+                for(int i=box_r; i<box_r+BOX; i++){
+                    for(int j=box_c; j<box_c+BOX; j++){
+                        if(i != row && j != col){
+                            cell_peers[n++] = i*SIDE+j;
+                        }
+                    }
+                }
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+// function to return the table of the cells of every unit (rows, columns and boxes), the table is built only once
+template<int BOX_SIZE>
+const typename SudokuBoardT<BOX_SIZE>::UNIT_TABLE& SudokuBoardT<BOX_SIZE>::units()
+{
+    static const UNIT_TABLE table = []{
+        UNIT_TABLE t;
+        for(int i=0; i<SIDE; i++){
+            int box_r = (i/BOX)*BOX; // row index of the box top left position
+            int box_c = (i%BOX)*BOX; // column index of the box top left position
+            for(int j=0; j<SIDE; j++){
+                t.cells[i][j] = i*SIDE+j;
+                t.cells[SIDE+i][j] = j*SIDE+i;
+                t.cells[2*SIDE+i][j] = (box_r+j/BOX)*SIDE+box_c+j%BOX;
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+// function to remove 'value' from the candidates of all peers of the cell (row,col)
+// peers left with one candidate are queued in 'forced_singles'
+// returns false when a contradiction is found (a peer with the same value or a peer with no candidates)
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::eliminateFromPeers(int row, int col, val value)
+{
+    const int* cell_peers = peers().cells[row*SIDE+col];
+    cmask vmask = valueBit(value);
+    for(int i=0; i<PEERS; i++){
+        CELL_INFO& peer = board[cell_peers[i]/SIDE][cell_peers[i]%SIDE];
+        if(peer.revealed){
+            if(peer.value == value){
+                SUDOKU_LOG(SUDOKU_LOG_DEBUG, "duplicate value in peer (" + QString::number(peer.coord.x()) + "," + QString::number(peer.coord.y()) + ")");
+                return false;
+            }
+        }
+        else if(peer.candidates & vmask){
+            saveCell(peer.coord.x(),peer.coord.y());
+            peer.candidates &= ~vmask;
+            int left = candidateCount(peer.candidates);
+            if(left == 0){
+                SUDOKU_LOG(SUDOKU_LOG_DEBUG, "no candidate left in peer (" + QString::number(peer.coord.x()) + "," + QString::number(peer.coord.y()) + ")");
+                return false;
+            }
+            if(left == 1){
+                forced_singles.push_back(cell_peers[i]);
+            }
+        }
+    }
+    return true;
+}
+
+// function to select the algorithm used by solve()
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setEngine(SOLVER_ENGINE e)
+{
+    engine = e;
+}
+
+// function to return the algorithm used by solve()
+template<int BOX_SIZE>
+SOLVER_ENGINE SudokuBoardT<BOX_SIZE>::getEngine() const
+{
+    return engine;
+}
+
+// function to set the largest subset or fish searched by deduction()
+// 1 keeps only the locked candidates, 0 disables all elimination techniques
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setMaxSubsetSize(int size)
+{
+    max_subset_size = qMin(size, int(MAX_SUBSET_SIZE));
+}
+
+// function to return the largest subset or fish searched by deduction()
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::getMaxSubsetSize() const
+{
+    return max_subset_size;
+}
+
+// function to select how the solver saves and restores its state when guessing
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setBacktrackingMode(BACKTRACKING_MODE mode)
+{
+    backtracking_mode = mode;
+}
+
+// function to return the current backtracking mode
+template<int BOX_SIZE>
+BACKTRACKING_MODE SudokuBoardT<BOX_SIZE>::getBacktrackingMode() const
+{
+    return backtracking_mode;
+}
+
+// function to record the state of the cell (row,col) on the trail before it is changed
+// nothing is recorded in snapshot mode or when there is no guess to return to
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::saveCell(int row, int col)
+{
+    if(backtracking_mode != BACKTRACK_TRAIL || trail_marks.isEmpty()){
+        return;
+    }
+    const CELL_INFO& cell = board[row][col];
+    trail.push_back({row*SIDE+col, cell.value, cell.revealed, cell.candidates, candidate_info[row][col]});
+    stats.saved_bytes += sizeof(TRAIL_ENTRY);
+}
+
+// function to save the current state before solving a guessed cell
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::pushChoicePoint()
+{
+    if(backtracking_mode == BACKTRACK_TRAIL){
+        trail_marks.push(trail.count());
+    }
+    else{
+        history.push({board,candidate_info});
+        stats.saved_bytes += CELLS*(sizeof(CELL_INFO)+sizeof(cmask));
+    }
+    stats.max_depth = qMax(stats.max_depth, historyDepth());
+}
+
+// function to return the number of saved guesses
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::historyDepth() const
+{
+    return backtracking_mode == BACKTRACK_TRAIL ? trail_marks.count() : history.count();
+}
+
+// function to go back to the state saved by the last pushChoicePoint and forget it
+// returns false if there is no saved state
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::restoreChoicePoint()
+{
+    if(backtracking_mode == BACKTRACK_TRAIL){
+        if(trail_marks.isEmpty()){
+            return false;
+        }
+        // rewind the cells changed since the guess, newest first
+        int mark = trail_marks.pop();
+        for(int i = trail.count()-1; i >= mark; i--){
+            const TRAIL_ENTRY& e = trail[i];
+            CELL_INFO& cell = board[e.index/SIDE][e.index%SIDE];
+            cell.value = e.value;
+            cell.revealed = e.revealed;
+            cell.candidates = e.candidates;
+            candidate_info[e.index/SIDE][e.index%SIDE] = e.guessed;
+        }
+        trail.resize(mark);
+        if(trace.isRecording()){
+            trace.record(TRACE_BACKTRACK, 0, 0);
+        }
+        return true;
+    }
+    if(history.isEmpty()){
+        return false;
+    }
+    board = history.top().board;
+    candidate_info = history.top().candidate_info;
+    history.pop();
+    if(trace.isRecording()){
+        trace.record(TRACE_BACKTRACK, 0, 0);
+    }
+    return true;
+}
+
+// function to solve the board using deduction techniques
+// deduction may finish when there is nothing to solve (STEP_NO_PROGRESS or STEP_PROGRESS)
+// or a failure occured during solving (STEP_CONTRADICTION)
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::deduction()
+{
+    bool solved_any = false;
+    STEP_RESULT solve1, solve2, solve3, solve4;
+    // deduction loop
+    while(true){
+        stats.deduction_passes++;
+        // Filling in 1-candidate cells
+        solve1 = solveCellsWithOneCandidate();
+        if(solve1 == STEP_CONTRADICTION){
+            return STEP_CONTRADICTION;
+        }
+
+        // Filling in numbers that can go only in one place in a row
+        solve2 = solveCellsInRow();
+        if(solve2 == STEP_CONTRADICTION){
+            return STEP_CONTRADICTION;
+        }
+
+        // Filling in numbers that can go only in one place in a column
+        solve3 = solveCellsInColumn();
+        if(solve3 == STEP_CONTRADICTION){
+            return STEP_CONTRADICTION;
+        }
+
+        // Filling in numbers that can go only in one place in a box
+        solve4 = solveCellsInBox();
+        if(solve4 == STEP_CONTRADICTION){
+            return STEP_CONTRADICTION;
+        }
+
+        if(solve1 == STEP_NO_PROGRESS && solve2 == STEP_NO_PROGRESS && solve3 == STEP_NO_PROGRESS && solve4 == STEP_NO_PROGRESS){
+            // no singles left, removing candidates may uncover new ones
+            STEP_RESULT eliminated = eliminateWithTechniques();
+            if(eliminated == STEP_CONTRADICTION){
+                return STEP_CONTRADICTION;
+            }
+            if(eliminated == STEP_NO_PROGRESS){
+                break;
+            }
+        }
+        solved_any = true;
+    }
+    return solved_any ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to solve one cell by guessing
+// returns:
+//  * STEP_PROGRESS - the guessed value was filled in
+//  * STEP_CONTRADICTION - the guessed value broke the board, the guess has to be undone
+//  * STEP_NO_GUESS - nothing is left to guess in any saved state
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::guessing()
+{
+    // compute coordinate and value of the next valid guess in the current state
+    GUESS guess = nextGuess();
+
+    // repeat until I guess the value in the current state
+    while(!guess.value){
+        // the current state is a dead end (its guessing cell has no value left to try),
+        // go to previous state if history is not empty, pop last state from stack
+        if(!restoreChoicePoint()){
+            // history is empty ... will I ever get here?
+            SUDOKU_LOG(SUDOKU_LOG_INFO, "history is empty ... will I ever get here?");
+            return STEP_NO_GUESS;
+        }
+        backtrack_count++;
+        guess = nextGuess();
+    }
+
+    // flag the guessed candidate in the current candidate_info
+    saveCell(guess.row,guess.col);
+    candidate_info[guess.row][guess.col] |= valueBit(guess.value);
+    // also in global candidate info
+    global_candidate_info[guess.row][guess.col] |= valueBit(guess.value);
+
+    // push the current state to stack
+    //  * board before solving with guessed value
+    //  * candidate_info after flagging the guessed value in the current candidate_info
+    pushChoicePoint();
+    guess_count++;
+    if(trace.isRecording()){
+        trace.record(TRACE_GUESS, guess.row*SIDE+guess.col, guess.value);
+    }
+
+    // solving
+    if(!solveCell(guess.row, guess.col, guess.value)){
+        return STEP_CONTRADICTION;
+    }
+    return STEP_PROGRESS;
+}
+
+// function answers the question if there are some
+// unrevealed cells in the current board with unguessed candidates
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::isThereSomethingToGuess()
+{
+    for(int row =0; row<board.count();row++){
+        for(int col =0; col<board[row].count();col++){
+            if(!board[row][col].revealed && (board[row][col].candidates & ~candidate_info[row][col])){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// function to compute the next guess in the current board
+// (the next unguessed candidate of the unrevealed cell with the fewest candidates)
+// returns:
+//  * value of guess
+//  * cell row
+//  * cell column
+//
+// if the cell has no unguessed candidate left, the state is a dead end and it returns INVALID_GUESS:
+// every value of that cell failed, so guessing in another cell cannot lead to a solution
+template<int BOX_SIZE>
+GUESS SudokuBoardT<BOX_SIZE>::nextGuess()
+{
+    // a choice point is restored to the same board, so the same cell is found for all its guesses
+    int fewest = SIDE+1;
+    int guess_row = -1;
+    int guess_col = -1;
+    for(int row =0; row<board.count() && fewest > 0;row++){
+        for(int col =0; col<board[row].count();col++){
+            const CELL_INFO& ci = board[row][col];
+            if(ci.revealed){
+                continue;
+            }
+            int count = candidateCount(ci.candidates);
+            if(count < fewest){
+                fewest = count;
+                guess_row = row;
+                guess_col = col;
+            }
+        }
+    }
+    if(guess_row < 0){
+        return INVALID_GUESS;
+    }
+    cmask unguessed = board[guess_row][guess_col].candidates & ~candidate_info[guess_row][guess_col];
+    if(!unguessed){
+        return INVALID_GUESS;
+    }
+    return {firstCandidate(unguessed),guess_row,guess_col};
+}
+
+
+// ******         *******
+// ****** SOLVING *******
+// ******         *******
+
+// function to solve Sudoku board with the selected engine, or from the solve cache when one is set
+// returns false when the board has no solution or the solve was cancelled by the progress handler
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::solve()
+{
+    trace.clear();
+    SudokuSolveCache::CACHE_KEY cache_key;
+    bool use_cache = solve_cache && BOX_SIZE == SUDOKU_BOX_SIZE;
+    if(use_cache && solveFromCache(cache_key)){
+        return true;
+    }
+
+    bool solved;
+    if(engine == ENGINE_DLX){
+        solved = solveWithDlx();
+    }
+    else if(engine == ENGINE_BITBOARD){
+        solved = solveWithBitboard();
+    }
+    else{
+        solved = solveWithDeduction();
+    }
+
+    if(use_cache && solved){
+        val solution[CELLS];
+        writeValues(solution);
+        solve_cache->insert(cache_key, solution);
+    }
+    return solved;
+}
+
+// function to solve Sudoku board using deduction and guessing
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::solveWithDeduction()
+{
+    SUDOKU_LOG(SUDOKU_LOG_INFO, "Solving, please wait, backtracking may take some while... ");
+    if(trace_enabled){
+        startTrace();
+    }
+    guess_count = 0;
+    backtrack_count = 0;
+    stats = SOLVE_STATS();
+    cancelled = false;
+    QElapsedTimer progress_timer;
+    progress_timer.start();
+    QElapsedTimer total_timer;
+    total_timer.start();
+    qint64 phase_start;
+    bool solved = false;
+    // while board is not solved
+    while(!(solved = isSolved())){
+        // PROGRESS
+        if(progress_handler && progress_timer.elapsed() >= progress_interval_ms){
+            SOLVE_PROGRESS progress = {guess_count, backtrack_count, historyDepth(), CELLS-getNumberOfUnrevealedCells()};
+            if(!progress_handler(progress)){
+                cancelled = true;
+                break;
+            }
+            progress_timer.restart();
+        }
+
+        // DEDUCTION
+        // if failure during deduction go to previous state, pop last state from stack
+        phase_start = total_timer.nsecsElapsed();
+        STEP_RESULT deduced = deduction();
+        stats.deduction_ns += total_timer.nsecsElapsed()-phase_start;
+        phase_start = total_timer.nsecsElapsed();
+        if(deduced == STEP_CONTRADICTION){
+            if(!restoreChoicePoint()){
+                break;
+            }
+            backtrack_count++;
+        }
+
+        // GUESSING
+        if(!isSolved()){
+            STEP_RESULT result = guessing();
+            if(result == STEP_NO_GUESS){
+                break;
+            }
+            // the guessed value broke the board, undo the guess
+            if(result == STEP_CONTRADICTION){
+                restoreChoicePoint();
+                backtrack_count++;
+            }
+        }
+        stats.guessing_ns += total_timer.nsecsElapsed()-phase_start;
+    }
+
+    trace.stop();
+    stats.guesses = guess_count;
+    stats.backtracks = backtrack_count;
+    stats.total_ns = total_timer.nsecsElapsed();
+    if(cancelled){
+        SUDOKU_LOG(SUDOKU_LOG_RESULT, "CANCELLED");
+        return false;
+    }
+    if(!solved){
+        SUDOKU_LOG(SUDOKU_LOG_RESULT, "NO SOLUTION");
+        return false;
+    }
+
+    // I will get here only when Sudoku is solved
+
+    SUDOKU_LOG(SUDOKU_LOG_RESULT, "SOLVED "+QDateTime::currentDateTime().toString(QString("dd.MM.yyyy,hh:mm:ss"))+"\n",MESSAGE_SOLVED);
+    return true;
+}
+
+// function to look the board up in the solve cache, 'key' is computed for the insert after a miss
+// a hit writes the cached solution of the board or of an isomorphic board, mapped back to this one
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::solveFromCache(SudokuSolveCache::CACHE_KEY& key)
+{
+    QElapsedTimer total_timer;
+    total_timer.start();
+    val puzzle[CELLS];
+    val solution[CELLS];
+    writeValues(puzzle);
+    key = SudokuSolveCache::key(puzzle);
+    if(!solve_cache->lookup(key, solution)){
+        return false;
+    }
+
+    writeSolution(solution);
+    cancelled = false;
+    guess_count = 0;
+    backtrack_count = 0;
+    stats = SOLVE_STATS();
+    stats.cache_hits = 1;
+    stats.total_ns = total_timer.nsecsElapsed();
+    SUDOKU_LOG(SUDOKU_LOG_RESULT, "SOLVED (cache) "+QDateTime::currentDateTime().toString(QString("dd.MM.yyyy,hh:mm:ss"))+"\n",MESSAGE_SOLVED);
+    return true;
+}
+
+// function to solve Sudoku board with the dancing links engine
+// every matrix row tried counts as a guess, every dead end as a backtrack
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::solveWithDlx()
+{
+    val puzzle[CELLS];
+    val solution[CELLS];
+    writeValues(puzzle);
+
+    cancelled = false;
+    QElapsedTimer progress_timer;
+    progress_timer.start();
+    QElapsedTimer total_timer;
+    total_timer.start();
+    if(progress_handler){
+        int clues = CELLS-getNumberOfUnrevealedCells();
+        dlx.setAbortCheck([this, &progress_timer, clues](){
+            if(progress_timer.elapsed() < progress_interval_ms){
+                return false;
+            }
+            progress_timer.restart();
+            SOLVE_PROGRESS progress = {dlx.getNodeCount(), dlx.getBacktrackCount(), dlx.getDepth(), clues+dlx.getDepth()};
+            return !progress_handler(progress);
+        });
+    }
+    else{
+        dlx.setAbortCheck(nullptr);
+    }
+
+    int found = dlx.solve(puzzle, solution);
+    // the check refers to this board and to the local timer, it must not outlive the solve
+    dlx.setAbortCheck(nullptr);
+    guess_count = int(dlx.getNodeCount());
+    backtrack_count = int(dlx.getBacktrackCount());
+    stats = SOLVE_STATS();
+    stats.guesses = guess_count;
+    stats.backtracks = backtrack_count;
+    stats.total_ns = total_timer.nsecsElapsed();
+    if(dlx.wasAborted()){
+        cancelled = true;
+        SUDOKU_LOG(SUDOKU_LOG_RESULT, "CANCELLED");
+        return false;
+    }
+    if(found == 0){
+        SUDOKU_LOG(SUDOKU_LOG_RESULT, "NO SOLUTION");
+        return false;
+    }
+
+    writeSolution(solution);
+    SUDOKU_LOG(SUDOKU_LOG_RESULT, "SOLVED (DLX) "+QDateTime::currentDateTime().toString(QString("dd.MM.yyyy,hh:mm:ss"))+"\n",MESSAGE_SOLVED);
+    return true;
+}
+
+// function to solve Sudoku board with the bitboard engine
+// every candidate tried in a branching cell counts as a guess, every dead end as a backtrack
+// the bitboards hold 9x9 boards only, larger boards are solved by the dancing links engine
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::solveWithBitboard()
+{
+    if(BOX_SIZE != SUDOKU_BOX_SIZE){
+        return solveWithDlx();
+    }
+
+    val puzzle[CELLS];
+    val solution[CELLS];
+    writeValues(puzzle);
+
+    cancelled = false;
+    QElapsedTimer progress_timer;
+    progress_timer.start();
+    QElapsedTimer total_timer;
+    total_timer.start();
+    if(progress_handler){
+        int clues = CELLS-getNumberOfUnrevealedCells();
+        bitboard.setAbortCheck([this, &progress_timer, clues](){
+            if(progress_timer.elapsed() < progress_interval_ms){
+                return false;
+            }
+            progress_timer.restart();
+            SOLVE_PROGRESS progress = {bitboard.getGuessCount(), bitboard.getBacktrackCount(), bitboard.getDepth(), clues+bitboard.getDepth()};
+            return !progress_handler(progress);
+        });
+    }
+    else{
+        bitboard.setAbortCheck(nullptr);
+    }
+
+    int found = bitboard.solve(puzzle, solution);
+    // the check refers to this board and to the local timer, it must not outlive the solve
+    bitboard.setAbortCheck(nullptr);
+    guess_count = int(bitboard.getGuessCount());
+    backtrack_count = int(bitboard.getBacktrackCount());
+    stats = SOLVE_STATS();
+    stats.guesses = guess_count;
+    stats.backtracks = backtrack_count;
+    stats.total_ns = total_timer.nsecsElapsed();
+    if(bitboard.wasAborted()){
+        cancelled = true;
+        SUDOKU_LOG(SUDOKU_LOG_RESULT, "CANCELLED");
+        return false;
+    }
+    if(found == 0){
+        SUDOKU_LOG(SUDOKU_LOG_RESULT, "NO SOLUTION");
+        return false;
+    }
+
+    writeSolution(solution);
+    SUDOKU_LOG(SUDOKU_LOG_RESULT, QString("SOLVED (bitboard, %1) ").arg(bitboard.isUsingAvx2() ? "AVX2" : "scalar")+QDateTime::currentDateTime().toString(QString("dd.MM.yyyy,hh:mm:ss"))+"\n",MESSAGE_SOLVED);
+    return true;
+}
+
+// function to count the solutions of 'puzzle' (CELLS values, 0 is an empty cell) up to 'limit'
+// with the fastest engine for the board size, the search is not cancellable
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::countPuzzleSolutions(const val* puzzle, int limit)
+{
+    val solution[CELLS];
+    if(BOX_SIZE == SUDOKU_BOX_SIZE){
+        bitboard.setAbortCheck(nullptr);
+        return bitboard.solve(puzzle, solution, limit);
+    }
+    dlx.setAbortCheck(nullptr);
+    return dlx.solve(puzzle, solution, limit);
+}
+
+// function to reveal all cells with the values of a solution found by an external engine
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::writeSolution(const val* solution)
+{
+    for(int i=0; i<CELLS; i++){
+        CELL_INFO& cell = board[i/SIDE][i%SIDE];
+        cell.value = solution[i];
+        cell.revealed = true;
+        cell.candidates = NO_CANDIDATES;
+    }
+}
+
+// function to return the counters of the last solve
+template<int BOX_SIZE>
+const SOLVE_STATS& SudokuBoardT<BOX_SIZE>::getStats() const
+{
+    return stats;
+}
+
+// function to share a cache of solved puzzles, solve() then answers repeated and isomorphic puzzles from it
+// the cache is used by 9x9 boards only and may be shared by boards on several threads, nullptr turns it off
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setSolveCache(SudokuSolveCache* cache)
+{
+    solve_cache = cache;
+}
+
+// function to record the steps of the following solves with the deduction engine (off by default)
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::setTraceEnabled(bool enabled)
+{
+    trace_enabled = enabled;
+}
+
+// function to return the steps of the last solve, empty when tracing was off or another engine solved
+template<int BOX_SIZE>
+const SudokuTraceT<BOX_SIZE>& SudokuBoardT<BOX_SIZE>::getTrace() const
+{
+    return trace;
+}
+
+// function to move the steps of the last solve into 'out' without copying them, the board's trace is left empty
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::takeTrace(SudokuTraceT<BOX_SIZE>& out)
+{
+    out = std::move(trace);
+    trace.clear();
+}
+
+// function to start recording the solve from the current board
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::startTrace()
+{
+    QVector<typename SudokuTraceT<BOX_SIZE>::TRACE_CELL> cells(CELLS);
+    for(int i=0; i<CELLS; i++){
+        const CELL_INFO& cell = board[i/SIDE][i%SIDE];
+        cells[i].value = cell.revealed ? cell.value : 0;
+        cells[i].candidates = cell.revealed ? NO_CANDIDATES : cell.candidates;
+    }
+    trace.start(cells);
+}
+
+// function to format the counters as text, techniques that were not used are left out
+template<int BOX_SIZE>
+QString SudokuBoardT<BOX_SIZE>::formatStats(const SOLVE_STATS& stats)
+{
+    QString text = "Deduction passes: " + QString::number(stats.deduction_passes) +
+                   ", placements: one candidate " + QString::number(stats.one_candidate_placements) +
+                   ", row " + QString::number(stats.row_placements) +
+                   ", column " + QString::number(stats.column_placements) +
+                   ", box " + QString::number(stats.box_placements) + "\n";
+    QString eliminations;
+    for(int t=0; t<TECHNIQUE_COUNT; t++){
+        if(stats.eliminations[t]){
+            eliminations += QString(eliminations.isEmpty() ? "" : ", ") + technique_name[t] + " " + QString::number(stats.eliminations[t]);
+        }
+    }
+    if(!eliminations.isEmpty()){
+        text += "Eliminations: " + eliminations + "\n";
+    }
+    text += "Guesses: " + QString::number(stats.guesses) +
+            ", backtracks: " + QString::number(stats.backtracks) +
+            ", max depth: " + QString::number(stats.max_depth) +
+            ", saved state: " + QString::number(stats.saved_bytes/1024) + " kB\n" +
+            (stats.cache_hits ? "Cache hits: " + QString::number(stats.cache_hits) + "\n" : QString()) +
+            "Time [ms] deduction: " + QString::number(stats.deduction_ns/1e6,'f',3) +
+            ", guessing: " + QString::number(stats.guessing_ns/1e6,'f',3) +
+            ", total: " + QString::number(stats.total_ns/1e6,'f',3);
+    return text;
+}
+
+// function to return the number of guesses made by the last solve
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::getGuessCount() const
+{
+    return guess_count;
+}
+
+// function to return true if the last solve was cancelled by the progress handler
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::wasCancelled() const
+{
+    return cancelled;
+}
+
+// function to return the number of times the last solve went back to a saved state
+template<int BOX_SIZE>
+int SudokuBoardT<BOX_SIZE>::getBacktrackCount() const
+{
+    return backtrack_count;
+}
+
+// function to solve all cells with 1 candidate
+// return STEP_PROGRESS if at least one cell was solved, STEP_CONTRADICTION if solving broke the board
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::solveCellsWithOneCandidate()
+{
+    bool solved_at_least_one = false;
+
+    // seed the queue with the current 1-candidate cells, placements then queue the peers they force
+    forced_singles.clear();
+    for(int row=0; row<SIDE; row++){
+        for(int col=0; col<SIDE; col++){
+            if(!board[row][col].revealed && candidateCount(board[row][col].candidates) == 1){
+                forced_singles.push_back(row*SIDE+col);
+            }
+        }
+    }
+    while(!forced_singles.isEmpty()){
+        int row = forced_singles.last()/SIDE;
+        int col = forced_singles.last()%SIDE;
+        forced_singles.removeLast();
+        // the cell may have been solved since it was queued
+        if(board[row][col].revealed){
+            continue;
+        }
+        if(!solveCell(row,col,firstCandidate(board[row][col].candidates))){
+            return STEP_CONTRADICTION;
+        }
+        SUDOKU_LOG(SUDOKU_LOG_DEBUG, "Solved by 1-candidate cell elimination: [" + QString::number(row) + "," + QString::number(col) + "]" + QString::number(board[row][col].value));
+        stats.one_candidate_placements++;
+        solved_at_least_one = true;
+    }
+    return solved_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to solve cells in row where missing values can go only in one place
+// return STEP_PROGRESS if at least one cell was solved, STEP_CONTRADICTION if solving broke the board
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::solveCellsInRow(){
+    bool solved_at_least_one = false;
+    cmask missingInRow;
+    for(int i=0; i<board.count();i++){
+        missingInRow = NO_CANDIDATES;
+        // find missing numbers in a row
+        for(int j=0;j<board[i].count();j++){
+            if(board[i][j].revealed){
+                missingInRow |= valueBit(board[i][j].value);
+            }
+        }
+        missingInRow = ALL_CANDIDATES & ~missingInRow;
+
+        // looking for the one place in a row for each of the missing numbers
+        int cnt =0;
+        int one_index = -1;
+        for(cmask m = missingInRow; m; m &= m-1){
+            val v = firstCandidate(m);
+            cnt = 0;
+            one_index = -1;
+            for(int j=0;j<board[i].count();j++){
+                if(!board[i][j].revealed && (board[i][j].candidates & valueBit(v))){
+                    one_index = j;
+                    cnt++;
+                    if(cnt>1){
+                        one_index = -1;
+                        break;
+                    }
+                }
+            }
+            if(one_index != -1){
+                if(!solveCell(i,one_index,v)){
+                    return STEP_CONTRADICTION;
+                }
+                SUDOKU_LOG(SUDOKU_LOG_DEBUG, "Solved by only place in row: [" + QString::number(i) + "," + QString::number(one_index) + "]" + QString::number(board[i][one_index].value));
+                stats.row_placements++;
+                solved_at_least_one = true;
+            }
+        }
+    }
+    return solved_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to solve cells in column where missing values can go only in one place
+// return STEP_PROGRESS if at least one cell was solved, STEP_CONTRADICTION if solving broke the board
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::solveCellsInColumn(){
+    bool solved_at_least_one = false;
+    cmask missingInCol;
+    for(int i=0; i<board[0].count();i++){
+        missingInCol = NO_CANDIDATES;
+        // find missing numbers in a column
+        for(int j=0;j<board.count();j++){
+            if(board[j][i].revealed){
+                missingInCol |= valueBit(board[j][i].value);
+            }
+        }
+        missingInCol = ALL_CANDIDATES & ~missingInCol;
+
+        // looking for the one place in a column for each of the missing numbers
+        int cnt =0;
+        int one_index = -1;
+        for(cmask m = missingInCol; m; m &= m-1){
+            val v = firstCandidate(m);
+            cnt = 0;
+            one_index = -1;
+            for(int j=0;j<board.count();j++){
+                if(!board[j][i].revealed && (board[j][i].candidates & valueBit(v))){
+                    one_index = j;
+                    cnt++;
+                    if(cnt>1){
+                        one_index = -1;
+                        break;
+                    }
+                }
+            }
+            if(one_index != -1){
+                if(!solveCell(one_index,i,v)){
+                    return STEP_CONTRADICTION;
+                }
+                SUDOKU_LOG(SUDOKU_LOG_DEBUG, "Solved by only place in column: [" + QString::number(one_index) + "," + QString::number(i) + "]" + QString::number(board[one_index][i].value));
+                stats.column_placements++;
+                solved_at_least_one = true;
+            }
+        }
+    }
+    return solved_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to solve cells in box where missing values can go only in one place
+// return STEP_PROGRESS if at least one cell was solved, STEP_CONTRADICTION if solving broke the board
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::solveCellsInBox(){
+    bool solved_at_least_one = false;
+    cmask missingInBox;
+    for(int i=0; i<SIDE;i+=BOX){
+        for(int j=0; j<SIDE;j+=BOX){
+            missingInBox = NO_CANDIDATES;
+            // find missing numbers in a box
+            int box_r = floor(i/BOX)*BOX; // row index of the box top left position
+            int box_c = floor(j/BOX)*BOX; // column index of the box top left position
+            for(int box_i = box_r;box_i<box_r+BOX;box_i++){
+                for(int box_j = box_c;box_j<box_c+BOX;box_j++){
+                    if(board[box_i][box_j].revealed){
+                        missingInBox |= valueBit(board[box_i][box_j].value);
+                    }
+                }
+            }
+            missingInBox = ALL_CANDIDATES & ~missingInBox;
+            // looking for the one place in a box for each of the missing numbers
+            int cnt =0;
+            int one_index_i = -1;
+            int one_index_j = -1;
+            bool jump_out = false;
+            for(cmask m = missingInBox; m; m &= m-1){
+                val v = firstCandidate(m);
+                cnt = 0;
+                one_index_i = -1;
+                one_index_j = -1;
+                for(int box_i = box_r;box_i<box_r+BOX;box_i++){
+                    jump_out = false;
+                    for(int box_j = box_c;box_j<box_c+BOX;box_j++){
+                        if(!board[box_i][box_j].revealed && (board[box_i][box_j].candidates & valueBit(v))){
+                            one_index_i = box_i;
+                            one_index_j = box_j;
+                            cnt++;
+                            if(cnt>1){
+                                one_index_i = -1;
+                                one_index_j = -1;
+                                jump_out = true;
+                                break;
+                            }
+                        }
+                    }
+                    if(jump_out){
+                        break;
+                    }
+                }
+                if(one_index_i != -1 && one_index_j != -1){
+                    if(!solveCell(one_index_i,one_index_j,v)){
+                        return STEP_CONTRADICTION;
+                    }
+                    SUDOKU_LOG(SUDOKU_LOG_DEBUG, "Solved by only place in box: [" + QString::number(one_index_i) + "," + QString::number(one_index_j) + "]" + QString::number(board[one_index_i][one_index_j].value));
+                    stats.box_placements++;
+                    solved_at_least_one = true;
+                }
+            }
+        }
+    }
+    return solved_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to rate the difficulty of the board by solving it with logic only
+// every step applies the easiest technique that makes progress: hidden singles in boxes (1.2),
+// hidden singles in rows and columns (1.5), naked singles (2.3), then the elimination techniques
+// by rating; the board is left unchanged
+template<int BOX_SIZE>
+DIFFICULTY_RATING SudokuBoardT<BOX_SIZE>::rate()
+{
+    DIFFICULTY_RATING r = {};
+    r.valid = true;
+    QVector<QVector<CELL_INFO>> saved_board = board;
+    SOLVE_STATS saved_stats = stats;
+    int saved_max_subset_size = max_subset_size;
+    max_subset_size = MAX_SUBSET_SIZE;
+
+    while(!isSolved()){
+        int unrevealed = getNumberOfUnrevealedCells();
+        double step_rating = 0;
+        STEP_RESULT result;
+        if((result = solveCellsInBox()) != STEP_NO_PROGRESS){
+            step_rating = 1.2;
+            r.hidden_singles += unrevealed-getNumberOfUnrevealedCells();
+        }
+        else if((result = solveCellsInRow()) != STEP_NO_PROGRESS || (result = solveCellsInColumn()) != STEP_NO_PROGRESS){
+            step_rating = 1.5;
+            r.hidden_singles += unrevealed-getNumberOfUnrevealedCells();
+        }
+        else if((result = solveCellsWithOneCandidate()) != STEP_NO_PROGRESS){
+            step_rating = 2.3;
+            r.naked_singles += unrevealed-getNumberOfUnrevealedCells();
+        }
+        else{
+            for(int i=0; i<TECHNIQUE_COUNT && result == STEP_NO_PROGRESS; i++){
+                ELIMINATION_TECHNIQUE t = rating_order[i];
+                if((result = applyTechnique(t)) != STEP_NO_PROGRESS){
+                    step_rating = technique_rating[t];
+                    r.techniques[t]++;
+                }
+            }
+        }
+
+        if(result == STEP_CONTRADICTION){
+            r.valid = false;
+            break;
+        }
+        if(result == STEP_NO_PROGRESS){
+            r.needs_guessing = true;
+            r.rating = RATING_GUESSING;
+            break;
+        }
+        r.steps++;
+        r.rating = qMax(r.rating, step_rating);
+    }
+
+    max_subset_size = saved_max_subset_size;
+    stats = saved_stats;
+    board = saved_board;
+    return r;
+}
+
+// function to format the rating and the histogram of the techniques that were used as one line of text
+template<int BOX_SIZE>
+QString SudokuBoardT<BOX_SIZE>::formatRating(const DIFFICULTY_RATING& rating)
+{
+    if(!rating.valid){
+        return "invalid";
+    }
+    QString text = QString::number(rating.rating,'f',1);
+    if(rating.needs_guessing){
+        text += " (needs guessing)";
+    }
+    text += ", hidden singles: " + QString::number(rating.hidden_singles) +
+            ", naked singles: " + QString::number(rating.naked_singles);
+    for(int t=0; t<TECHNIQUE_COUNT; t++){
+        if(rating.techniques[t]){
+            text += QString(", ") + technique_name[t] + ": " + QString::number(rating.techniques[t]);
+        }
+    }
+    return text;
+}
+
+// function to run the candidate elimination techniques in ELIMINATION_TECHNIQUE order (cheapest first)
+// returns at the first technique that removed candidates, so that the singles run again before anything costlier
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::eliminateWithTechniques()
+{
+    for(int t=0; t<TECHNIQUE_COUNT; t++){
+        STEP_RESULT result = applyTechnique(ELIMINATION_TECHNIQUE(t));
+        if(result == STEP_PROGRESS){
+            stats.eliminations[t]++;
+        }
+        if(result != STEP_NO_PROGRESS){
+            return result;
+        }
+    }
+    return STEP_NO_PROGRESS;
+}
+
+// function to run one elimination technique, techniques larger than max_subset_size are skipped
+// return STEP_PROGRESS if at least one candidate was removed, STEP_CONTRADICTION if the board is broken
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::applyTechnique(ELIMINATION_TECHNIQUE technique)
+{
+    // number of cells or lines of each technique, in ELIMINATION_TECHNIQUE order
+    static const int technique_size[TECHNIQUE_COUNT] = {1, 2, 2, 2, 3, 3, 3, 4, 4, 4};
+    int size = technique_size[technique];
+    if(size > max_subset_size){
+        return STEP_NO_PROGRESS;
+    }
+    switch(technique){
+    case TECHNIQUE_LOCKED_CANDIDATES:
+        return eliminateLockedCandidates();
+    case TECHNIQUE_NAKED_PAIR:
+    case TECHNIQUE_NAKED_TRIPLE:
+    case TECHNIQUE_NAKED_QUAD:
+        return eliminateNakedSubsets(size);
+    case TECHNIQUE_HIDDEN_PAIR:
+    case TECHNIQUE_HIDDEN_TRIPLE:
+    case TECHNIQUE_HIDDEN_QUAD:
+        return eliminateHiddenSubsets(size);
+    case TECHNIQUE_X_WING:
+    case TECHNIQUE_SWORDFISH:
+    case TECHNIQUE_JELLYFISH:
+        return eliminateFish(size);
+    default:
+        return STEP_NO_PROGRESS;
+    }
+}
+
+// function to fill 'p' with the places of every value in every unit
+template<int BOX_SIZE>
+void SudokuBoardT<BOX_SIZE>::computeUnitPlaces(UNIT_PLACES& p) const
+{
+    for(int u=0; u<UNITS; u++){
+        const int* unit = units().cells[u];
+        for(int v=0; v<SIDE; v++){
+            p.places[u][v] = 0;
+        }
+        for(int i=0; i<SIDE; i++){
+            const CELL_INFO& cell = board[unit[i]/SIDE][unit[i]%SIDE];
+            if(cell.revealed){
+                continue;
+            }
+            for(cmask m = cell.candidates; m; m &= m-1){
+                p.places[u][firstCandidate(m)-1] |= quint32(1u << i);
+            }
+        }
+    }
+}
+
+// function to remove the candidates in 'mask' from the unrevealed cell 'index' (row*SIDE+col)
+// returns false when the cell is left without candidates
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::eliminateCandidates(int index, cmask mask)
+{
+    int row = index/SIDE;
+    int col = index%SIDE;
+    saveCell(row,col);
+    if(trace.isRecording()){
+        for(cmask m = board[row][col].candidates & mask; m; m &= m-1){
+            trace.record(TRACE_ELIMINATE, index, firstCandidate(m));
+        }
+    }
+    board[row][col].candidates &= ~mask;
+    return board[row][col].candidates != NO_CANDIDATES;
+}
+
+// function to remove the candidates in 'mask' from the cells of unit 'u' outside the positions in 'keep'
+// 'technique' names the technique in the debug messages
+// return STEP_PROGRESS if at least one candidate was removed, STEP_CONTRADICTION if a cell was left without candidates
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::eliminateFromUnit(int u, quint32 keep, cmask mask, const char* technique)
+{
+    bool eliminated_at_least_one = false;
+    const int* unit = units().cells[u];
+    for(int i=0; i<SIDE; i++){
+        const CELL_INFO& cell = board[unit[i]/SIDE][unit[i]%SIDE];
+        if((keep & (1u << i)) || cell.revealed || !(cell.candidates & mask)){
+            continue;
+        }
+        SUDOKU_LOG(SUDOKU_LOG_DEBUG, QString(technique) + " in unit " + QString::number(u) + " removes candidates from [" + QString::number(cell.coord.x()) + "," + QString::number(cell.coord.y()) + "]");
+        if(!eliminateCandidates(unit[i], mask)){
+            return STEP_CONTRADICTION;
+        }
+        eliminated_at_least_one = true;
+    }
+    return eliminated_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to remove candidates with locked candidates:
+// * pointing - the places of a value in a box are in one row (column), the value is removed from the rest of the row (column)
+// * claiming - the places of a value in a row (column) are in one box, the value is removed from the rest of the box
+// return STEP_PROGRESS if at least one candidate was removed, STEP_CONTRADICTION if the board is broken
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::eliminateLockedCandidates()
+{
+    UNIT_PLACES p;
+    computeUnitPlaces(p);
+    // unit positions of the k-th row and the k-th column of a box, the k-th box segment of a row or column
+    quint32 box_row[BOX];
+    quint32 box_col[BOX];
+    for(int k=0; k<BOX; k++){
+        box_row[k] = ((1u << BOX)-1) << (k*BOX);
+        box_col[k] = 0;
+        for(int i=0; i<BOX; i++){
+            box_col[k] |= 1u << (i*BOX+k);
+        }
+    }
+
+    bool eliminated_at_least_one = false;
+    for(int v=1; v<=SIDE; v++){
+        for(int b=0; b<SIDE; b++){
+            int box_r = (b/BOX)*BOX; // row index of the box top left position
+            int box_c = (b%BOX)*BOX; // column index of the box top left position
+            quint32 in_box = p.places[2*SIDE+b][v-1];
+            if(!in_box){
+                continue;
+            }
+            for(int k=0; k<BOX; k++){
+                STEP_RESULT pointing = STEP_NO_PROGRESS;
+                if((in_box & ~box_row[k]) == 0){
+                    pointing = eliminateFromUnit(box_r+k, box_row[b%BOX], valueBit(v), "Pointing");
+                }
+                else if((in_box & ~box_col[k]) == 0){
+                    pointing = eliminateFromUnit(SIDE+box_c+k, box_row[b/BOX], valueBit(v), "Pointing");
+                }
+                if(pointing == STEP_CONTRADICTION){
+                    return STEP_CONTRADICTION;
+                }
+                eliminated_at_least_one |= pointing == STEP_PROGRESS;
+            }
+        }
+        // rows (lines 0-8) and columns (lines 9-17), segment k of a line is in box k of its band or stack
+        for(int line=0; line<2*SIDE; line++){
+            quint32 in_line = p.places[line][v-1];
+            if(!in_line){
+                continue;
+            }
+            int i = line%SIDE;
+            for(int k=0; k<BOX; k++){
+                if((in_line & ~box_row[k]) != 0){
+                    continue;
+                }
+                STEP_RESULT claiming;
+                if(line < SIDE){
+                    int b = (i/BOX)*BOX+k;
+                    claiming = eliminateFromUnit(2*SIDE+b, box_row[i%BOX], valueBit(v), "Claiming");
+                }
+                else{
+                    int b = k*BOX+i/BOX;
+                    claiming = eliminateFromUnit(2*SIDE+b, box_col[i%BOX], valueBit(v), "Claiming");
+                }
+                if(claiming == STEP_CONTRADICTION){
+                    return STEP_CONTRADICTION;
+                }
+                eliminated_at_least_one |= claiming == STEP_PROGRESS;
+            }
+        }
+    }
+    return eliminated_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to find 'size' cells of a unit whose candidates together are exactly 'size' values,
+// the values then belong to these cells and are removed from the other cells of the unit
+// return STEP_PROGRESS if at least one candidate was removed, STEP_CONTRADICTION if 'size' cells have fewer values
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::eliminateNakedSubsets(int size)
+{
+    bool eliminated_at_least_one = false;
+    for(int u=0; u<UNITS; u++){
+        const int* unit = units().cells[u];
+        // positions in the unit of the cells small enough to be in a subset
+        int members[SIDE];
+        int member_count = 0;
+        int open_count = 0;
+        for(int i=0; i<SIDE; i++){
+            const CELL_INFO& cell = board[unit[i]/SIDE][unit[i]%SIDE];
+            if(cell.revealed){
+                continue;
+            }
+            open_count++;
+            int n = candidateCount(cell.candidates);
+            if(n >= 2 && n <= size){
+                members[member_count++] = i;
+            }
+        }
+        // the subset has to leave at least one other unrevealed cell
+        if(member_count < size || open_count <= size){
+            continue;
+        }
+
+        // every selection of 'size' members
+        for(quint32 selection = (1u << size)-1; selection < (1u << member_count); selection = nextSelection(selection)){
+            cmask values = NO_CANDIDATES;
+            quint32 positions = 0;
+            for(int k=0; k<member_count; k++){
+                if(selection & (1u << k)){
+                    values |= board[unit[members[k]]/SIDE][unit[members[k]]%SIDE].candidates;
+                    positions |= 1u << members[k];
+                }
+            }
+            int n = candidateCount(values);
+            if(n < size){
+                return STEP_CONTRADICTION;
+            }
+            if(n > size){
+                continue;
+            }
+            STEP_RESULT result = eliminateFromUnit(u, positions, values, "Naked subset");
+            if(result == STEP_CONTRADICTION){
+                return STEP_CONTRADICTION;
+            }
+            eliminated_at_least_one |= result == STEP_PROGRESS;
+        }
+    }
+    return eliminated_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to find 'size' values of a unit that fit together in only 'size' cells,
+// the cells then hold these values and their other candidates are removed
+// return STEP_PROGRESS if at least one candidate was removed, STEP_CONTRADICTION if 'size' values fit in fewer cells
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::eliminateHiddenSubsets(int size)
+{
+    UNIT_PLACES p;
+    computeUnitPlaces(p);
+    quint32 all_positions = (1u << SIDE)-1;
+    bool eliminated_at_least_one = false;
+    for(int u=0; u<UNITS; u++){
+        // values with one place are hidden singles, left to solveCellsInRow/Column/Box
+        val members[SIDE];
+        int member_count = 0;
+        quint32 open = 0;
+        for(int v=1; v<=SIDE; v++){
+            int n = qPopulationCount(p.places[u][v-1]);
+            if(n >= 2 && n <= size){
+                members[member_count++] = val(v);
+            }
+            open |= p.places[u][v-1];
+        }
+        // the cells of the subset have to hold other candidates too
+        if(member_count < size || qPopulationCount(open) <= uint(size)){
+            continue;
+        }
+
+        // every selection of 'size' members
+        for(quint32 selection = (1u << size)-1; selection < (1u << member_count); selection = nextSelection(selection)){
+            cmask values = NO_CANDIDATES;
+            quint32 positions = 0;
+            for(int k=0; k<member_count; k++){
+                if(selection & (1u << k)){
+                    values |= valueBit(members[k]);
+                    positions |= p.places[u][members[k]-1];
+                }
+            }
+            int n = qPopulationCount(positions);
+            if(n < size){
+                return STEP_CONTRADICTION;
+            }
+            if(n > size){
+                continue;
+            }
+            STEP_RESULT result = eliminateFromUnit(u, all_positions & ~positions, cmask(ALL_CANDIDATES & ~values), "Hidden subset");
+            if(result == STEP_CONTRADICTION){
+                return STEP_CONTRADICTION;
+            }
+            eliminated_at_least_one |= result == STEP_PROGRESS;
+        }
+    }
+    return eliminated_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to find fish of 'size' lines (X-Wing 2, Swordfish 3, Jellyfish 4): when the places of a value in
+// 'size' rows are all in the same 'size' columns, the value is removed from the other rows of these columns
+// (and the same with rows and columns swapped)
+// return STEP_PROGRESS if at least one candidate was removed, STEP_CONTRADICTION if 'size' lines share fewer columns
+template<int BOX_SIZE>
+STEP_RESULT SudokuBoardT<BOX_SIZE>::eliminateFish(int size)
+{
+    UNIT_PLACES p;
+    computeUnitPlaces(p);
+    bool eliminated_at_least_one = false;
+    // base lines are the rows (units 0-8) with column covers (units 9-17), then the other way round
+    for(int orientation=0; orientation<2; orientation++){
+        int base_first = orientation == 0 ? 0 : SIDE;
+        int cover_first = orientation == 0 ? SIDE : 0;
+        for(int v=1; v<=SIDE; v++){
+            int members[SIDE];
+            int member_count = 0;
+            for(int i=0; i<SIDE; i++){
+                int n = qPopulationCount(p.places[base_first+i][v-1]);
+                if(n >= 2 && n <= size){
+                    members[member_count++] = i;
+                }
+            }
+            if(member_count < size){
+                continue;
+            }
+
+            // every selection of 'size' base lines
+            for(quint32 selection = (1u << size)-1; selection < (1u << member_count); selection = nextSelection(selection)){
+                quint32 covers = 0;
+                quint32 bases = 0;
+                for(int k=0; k<member_count; k++){
+                    if(selection & (1u << k)){
+                        covers |= p.places[base_first+members[k]][v-1];
+                        bases |= 1u << members[k];
+                    }
+                }
+                int n = qPopulationCount(covers);
+                if(n < size){
+                    return STEP_CONTRADICTION;
+                }
+                if(n > size){
+                    continue;
+                }
+                for(quint32 m = covers; m; m &= m-1){
+                    STEP_RESULT result = eliminateFromUnit(cover_first+qCountTrailingZeroBits(m), bases, valueBit(v), "Fish");
+                    if(result == STEP_CONTRADICTION){
+                        return STEP_CONTRADICTION;
+                    }
+                    eliminated_at_least_one |= result == STEP_PROGRESS;
+                }
+            }
+        }
+    }
+    return eliminated_at_least_one ? STEP_PROGRESS : STEP_NO_PROGRESS;
+}
+
+// function to solve cell at coordinates ('row','col') with value 'value' and check if does not
+// break the solution, only the 20 peers of the cell are updated and checked
+template<int BOX_SIZE>
+bool SudokuBoardT<BOX_SIZE>::solveCell(int row, int col, val value)
+{
+    // actual solving
+    saveCell(row,col);
+    if(trace.isRecording()){
+        trace.record(TRACE_PLACE, row*SIDE+col, value);
+    }
+    board[row][col].value = value;
+    board[row][col].candidates = NO_CANDIDATES;
+    board[row][col].revealed = true;
+
+    bool isgood = eliminateFromPeers(row,col,value);
+    SUDOKU_LOG(SUDOKU_LOG_DEBUG, QString("SOLVE=") + (isgood ? "CORRECT: " : "ERROR: ") + "when solving cell (" +
+               QString::number(row+1) + "," + QString::number(col+1) + ") with value " + QString::number(value));
+    return isgood;
+}
+
+// the board is compiled for these box sizes only
+template class SudokuBoardT<3>;
+template class SudokuBoardT<4>;
+template class SudokuBoardT<5>;
@@ -0,0 +1,405 @@
+#ifndef SUDOKUBOARD_H
+#define SUDOKUBOARD_H
+
+#include <QVector>
+#include <QStack>
+#include <QString>
+#include <QPoint>
+#include <QDebug>
+#include <functional>
+#include "sudokutypes.h"
+#include "dlxsolver.h"
+#include "bitboardsolver.h"
+#include "sudokurandom.h"
+#include "sudokutrace.h"
+#include "sudokucache.h"
+
+typedef struct{
+    int value;
+    int row;
+    int col;
+} GUESS;
+
+#define INVALID_GUESS GUESS{0,-1,-1}
+
+// how the state is saved at each guess and restored when the guess fails
+// * BACKTRACK_SNAPSHOT - copy of the whole board and candidate_info
+// * BACKTRACK_TRAIL - only the cells changed since the guess are recorded and rewound in place
+typedef enum {
+    BACKTRACK_SNAPSHOT,
+    BACKTRACK_TRAIL
+} BACKTRACKING_MODE;
+
+// algorithm used by solve()
+// * ENGINE_DEDUCTION - deduction techniques with guessing and backtracking
+// * ENGINE_DLX - exact cover search with dancing links (Algorithm X)
+// * ENGINE_BITBOARD - singles on vectorized candidate bitboards with backtracking, AVX2 when available
+//                     (9x9 only, larger boards fall back to ENGINE_DLX)
+typedef enum {
+    ENGINE_DEDUCTION,
+    ENGINE_DLX,
+    ENGINE_BITBOARD
+} SOLVER_ENGINE;
+
+// how generate() fills the solved grid
+// * GENERATE_BACKTRACKING - random values cell by cell with backtracking
+// * GENERATE_PERMUTATION - random value, row, band, column and stack permutations of a seed grid,
+//                          a new seed grid is filled by backtracking every SEED_GRID_REUSE grids
+typedef enum {
+    GENERATE_BACKTRACKING,
+    GENERATE_PERMUTATION
+} GENERATOR_MODE;
+
+#define SEED_GRID_REUSE 1024
+
+// dancing links nodes a grid completion may visit before fillGrid() retries with other random boxes
+#define FILL_GRID_NODE_LIMIT 20000
+
+// result of a solving step
+typedef enum {
+    STEP_NO_PROGRESS,   // nothing was solved
+    STEP_PROGRESS,      // at least one cell was solved
+    STEP_CONTRADICTION, // the board was broken, the last guess has to be undone
+    STEP_NO_GUESS       // nothing is left to guess in any saved state
+} STEP_RESULT;
+
+// largest naked/hidden subset and fish searched by deduction()
+#define MAX_SUBSET_SIZE 4
+
+// candidate elimination techniques used by deduction() when no single is left, ordered by cost
+typedef enum {
+    TECHNIQUE_LOCKED_CANDIDATES,    // pointing and claiming
+    TECHNIQUE_NAKED_PAIR,
+    TECHNIQUE_HIDDEN_PAIR,
+    TECHNIQUE_X_WING,
+    TECHNIQUE_NAKED_TRIPLE,
+    TECHNIQUE_HIDDEN_TRIPLE,
+    TECHNIQUE_SWORDFISH,
+    TECHNIQUE_NAKED_QUAD,
+    TECHNIQUE_HIDDEN_QUAD,
+    TECHNIQUE_JELLYFISH,
+    TECHNIQUE_COUNT
+} ELIMINATION_TECHNIQUE;
+
+// rating of puzzles that logic alone does not solve, above every technique (no chains are implemented)
+#define RATING_GUESSING 10.0
+
+// difficulty of a puzzle found by solving it with logic only, always taking the easiest step available
+// 'rating' follows the Sudoku Explainer scale: the rating of the hardest step needed
+typedef struct {
+    double rating;                      // 0 for an already solved board
+    bool valid;                         // false when the clues contradict each other
+    bool needs_guessing;                // logic got stuck, 'rating' is RATING_GUESSING
+    int steps;                          // number of steps taken
+    int hidden_singles;                 // cells placed by hidden singles
+    int naked_singles;                  // cells placed by naked singles
+    int techniques[TECHNIQUE_COUNT];    // successful applications of every elimination technique
+} DIFFICULTY_RATING;
+
+// counters of the last solve(), see getStats()
+// the engines other than ENGINE_DEDUCTION fill only guesses, backtracks and total_ns
+typedef struct {
+    qint64 deduction_passes;                // rounds of the deduction loop
+    qint64 one_candidate_placements;        // cells solved by solveCellsWithOneCandidate
+    qint64 row_placements;                  // cells solved by solveCellsInRow
+    qint64 column_placements;               // cells solved by solveCellsInColumn
+    qint64 box_placements;                  // cells solved by solveCellsInBox
+    qint64 eliminations[TECHNIQUE_COUNT];   // successful applications of every elimination technique
+    qint64 guesses;
+    qint64 backtracks;
+    int max_depth;                          // largest number of nested guesses
+    qint64 saved_bytes;                     // bytes of board state saved for backtracking (snapshots or trail)
+    qint64 deduction_ns;                    // wall time in deduction()
+    qint64 guessing_ns;                     // wall time in guessing and restoring saved states
+    qint64 total_ns;
+    qint64 cache_hits;                      // solves answered by the solve cache, see setSolveCache()
+} SOLVE_STATS;
+
+// function to add the counters of 's' to 'total', max_depth is the largest of both
+inline void addSolveStats(SOLVE_STATS& total, const SOLVE_STATS& s)
+{
+    total.deduction_passes += s.deduction_passes;
+    total.one_candidate_placements += s.one_candidate_placements;
+    total.row_placements += s.row_placements;
+    total.column_placements += s.column_placements;
+    total.box_placements += s.box_placements;
+    for(int t=0; t<TECHNIQUE_COUNT; t++){
+        total.eliminations[t] += s.eliminations[t];
+    }
+    total.guesses += s.guesses;
+    total.backtracks += s.backtracks;
+    total.max_depth = qMax(total.max_depth, s.max_depth);
+    total.saved_bytes += s.saved_bytes;
+    total.deduction_ns += s.deduction_ns;
+    total.guessing_ns += s.guessing_ns;
+    total.total_ns += s.total_ns;
+    total.cache_hits += s.cache_hits;
+}
+
+// compile-time logging levels, messages above SUDOKU_LOG_LEVEL are left out of the build
+// * SUDOKU_LOG_NONE - no messages at all
+// * SUDOKU_LOG_RESULT - generated boards and the outcome of every solve (default in release builds)
+// * SUDOKU_LOG_INFO - also notices such as the start of a solve (default in debug builds)
+// * SUDOKU_LOG_DEBUG - also every deduction step, for following a single solve (DEFINES += SUDOKU_LOG_LEVEL=3)
+#define SUDOKU_LOG_NONE 0
+#define SUDOKU_LOG_RESULT 1
+#define SUDOKU_LOG_INFO 2
+#define SUDOKU_LOG_DEBUG 3
+
+#ifndef SUDOKU_LOG_LEVEL
+#ifdef QT_NO_DEBUG
+#define SUDOKU_LOG_LEVEL SUDOKU_LOG_RESULT
+#else
+#define SUDOKU_LOG_LEVEL SUDOKU_LOG_INFO
+#endif
+#endif
+
+// kind of message sent by the solver, the UI decides how to display it
+typedef enum {
+    MESSAGE_INFO,
+    MESSAGE_GENERATED,
+    MESSAGE_SOLVED
+} MESSAGE_TYPE;
+
+// optional callbacks for a UI following the solver, the board is Qt widgets free and runs headless
+// a UI showing the solving steps replays the recorded trace (setTraceEnabled) instead of following the solver live
+typedef std::function<void(const QString& message, MESSAGE_TYPE type)> MESSAGE_HANDLER;
+
+// progress of a running solve
+typedef struct {
+    qint64 guesses;
+    qint64 backtracks;
+    int depth;  // number of guesses saved for backtracking
+    int filled; // number of revealed cells
+} SOLVE_PROGRESS;
+
+// progress callback, called from the solving thread at most once per progress interval,
+// returning false cancels the solve
+typedef std::function<bool(const SOLVE_PROGRESS& progress)> PROGRESS_HANDLER;
+
+// Sudoku board of BOX_SIZE x BOX_SIZE boxes, the geometry and the candidate mask width are fixed at compile time
+// the implementation is explicitly instantiated for 9x9, 16x16 and 25x25 boards in sudokuboard.cpp
+template<int BOX_SIZE>
+class SudokuBoardT
+{
+public:
+    // board geometry, CANDIDATE_COUNT values are the numbers 1..SIDE
+    enum {
+        BOX = BOX_SIZE,
+        SIDE = BOX_SIZE*BOX_SIZE,
+        CELLS = SIDE*SIDE,
+        PEERS = 2*(SIDE-1)+(BOX_SIZE-1)*(BOX_SIZE-1),
+        UNITS = 3*SIDE,
+        ALL_CANDIDATES = int((quint64(1) << SIDE)-1)
+    };
+
+    // compact encodings of a board: bits of a packed value 0..SIDE and of a given digit 1..SIDE stored as value-1,
+    // bytes of the packed form (41 for 9x9) and the largest given mask and digits form (51 for 9x9)
+    enum {
+        VALUE_BITS = SIDE < 16 ? 4 : 5,
+        DIGIT_BITS = SIDE <= 16 ? 4 : 5,
+        PACKED_SIZE = (CELLS*VALUE_BITS+7)/8,
+        GIVENS_MAX_SIZE = (CELLS+CELLS*DIGIT_BITS+7)/8
+    };
+
+    // candidate bitmask wide enough for SIDE values, shadows the 9x9 cmask inside the class
+    typedef typename SudokuGeometry<BOX_SIZE>::MASK cmask;
+
+    typedef struct {
+        QPoint coord;
+        val value;
+        bool revealed;
+        cmask candidates;
+    } CELL_INFO;
+
+    typedef struct{
+        QVector<QVector<CELL_INFO>> board;
+        QVector<QVector<cmask>> candidate_info;
+    } HISTORY_SNAPSHOT;
+
+    // state of a cell before it was changed, recorded on the trail in trail backtracking mode
+    typedef struct{
+        int index; // row*SIDE+col
+        val value;
+        bool revealed;
+        cmask candidates;
+        cmask guessed; // candidate_info of the cell
+    } TRAIL_ENTRY;
+
+    // cells sharing a row, column or box with each cell, cell index is row*SIDE+col
+    typedef struct{
+        int cells[CELLS][PEERS];
+    } PEER_TABLE;
+
+    // cells of every unit, units 0..SIDE-1 are rows, then columns and boxes
+    typedef struct{
+        int cells[UNITS][SIDE];
+    } UNIT_TABLE;
+
+    // places of every value in every unit, bit i is set when the i-th cell of the unit (UNIT_TABLE order)
+    // is unrevealed and has the value as a candidate
+    typedef struct{
+        quint32 places[UNITS][SIDE];
+    } UNIT_PLACES;
+
+    SudokuBoardT();
+
+    // mask with only the bit of value 'v' set
+    static cmask valueBit(val v){ return cmask(cmask(1) << (v-1)); }
+
+    // public API
+    void generate();
+    void generate(quint64 seed);
+    void generateUnique();
+    void generateUnique(quint64 seed);
+    void generateGrid(val* grid);
+    void setSeed(quint64 seed);
+    void setGeneratorMode(GENERATOR_MODE mode);
+    GENERATOR_MODE getGeneratorMode() const;
+    int countSolutions(int limit = 2);
+    DIFFICULTY_RATING rate();
+    static QString formatRating(const DIFFICULTY_RATING& rating);
+    void reset();
+    bool solve();
+
+    // encodings of the revealed values: CELLS values, CELLS characters, PACKED_SIZE bytes,
+    // or a given mask and digits form of at most GIVENS_MAX_SIZE bytes; the load functions return false
+    // if the puzzle is not valid
+    bool loadValues(const val* values);
+    void writeValues(val* values) const;
+    bool loadString(const char* text);
+    void writeString(char* text) const;
+    bool loadPacked(const uchar* packed);
+    void writePacked(uchar* packed) const;
+    bool loadGivens(const uchar* givens, int* size = nullptr);
+    int writeGivens(uchar* givens) const;
+
+    // bulk conversion of 'count' boards of CELLS values each, the caller provides all buffers
+    static bool decodeStrings(const char* text, qint64 count, val* values);
+    static void encodeStrings(const val* values, qint64 count, char* text);
+    static void packBoards(const val* values, qint64 count, uchar* packed);
+    static void unpackBoards(const uchar* packed, qint64 count, val* values);
+    static qint64 encodeGivens(const val* values, qint64 count, uchar* givens);
+    static qint64 decodeGivens(const uchar* givens, qint64 count, val* values);
+
+    void printGenerated();
+    void printBoard(const QVector<QVector<CELL_INFO>>&);
+    void printGuessedCandidates(const QVector<QVector<CELL_INFO> > & board, const QVector<QVector<cmask> > &candidate_info);
+    void print(bool detailed =false);
+    bool isSolved();
+    void setEngine(SOLVER_ENGINE engine);
+    SOLVER_ENGINE getEngine() const;
+    void setBacktrackingMode(BACKTRACKING_MODE mode);
+    BACKTRACKING_MODE getBacktrackingMode() const;
+    void setMaxSubsetSize(int size);
+    int getMaxSubsetSize() const;
+    int getGuessCount() const;
+    const SOLVE_STATS& getStats() const;
+    void setSolveCache(SudokuSolveCache* cache);
+    void setTraceEnabled(bool enabled);
+    const SudokuTraceT<BOX_SIZE>& getTrace() const;
+    void takeTrace(SudokuTraceT<BOX_SIZE>& out);
+    static QString formatStats(const SOLVE_STATS& stats);
+    int getBacktrackCount() const;
+    bool wasCancelled() const;
+    bool isGood(QString& whatHappened);
+    
+    const QVector<QVector<CELL_INFO>>& getBoard() const;
+    cmask getCandidates(int,int) const;
+    QVector<CELL_INFO> getNeighbors(int,int);
+    cmask getUniqueNeighborValues(int,int) const;
+    QVector<CELL_INFO> getUnrevealedCellsWithNCandidates(int n);
+    int getNumberOfUnrevealedCells();
+
+    // candidate elimination techniques, usable outside solve()
+    STEP_RESULT applyTechnique(ELIMINATION_TECHNIQUE technique);
+    STEP_RESULT eliminateLockedCandidates();
+    STEP_RESULT eliminateNakedSubsets(int size);
+    STEP_RESULT eliminateHiddenSubsets(int size);
+    STEP_RESULT eliminateFish(int size);
+
+    // UI callbacks
+    void setMessageHandler(MESSAGE_HANDLER handler);
+    void setProgressHandler(PROGRESS_HANDLER handler, int interval_ms = 100);
+
+private:
+    // data members
+    SOLVER_ENGINE engine;
+    DlxSolverT<BOX_SIZE> dlx;
+    BitboardSolver bitboard;
+    BACKTRACKING_MODE backtracking_mode;
+    int max_subset_size;
+    SudokuRandom random;
+    GENERATOR_MODE generator_mode;
+    val seed_grid[CELLS];  // grid permuted by GENERATE_PERMUTATION
+    int seed_grid_uses;    // grids made from seed_grid, 0 makes a new one
+    QStack<HISTORY_SNAPSHOT> history;
+    QVector<TRAIL_ENTRY> trail;
+    QStack<int> trail_marks; // trail size at each guess
+    QVector<QVector<CELL_INFO>> board;
+    QVector<QVector<CELL_INFO>> originalBoard;
+    QVector<QVector<cmask>> candidate_info;
+    QVector<QVector<cmask>> global_candidate_info;
+    QVector<int> forced_singles; // cells left with one candidate by the last placements
+    int guess_count;
+    int backtrack_count;
+    SOLVE_STATS stats;
+    SudokuSolveCache* solve_cache; // not owned, 9x9 boards only
+    bool trace_enabled;
+    SudokuTraceT<BOX_SIZE> trace; // steps of the last solve with the deduction engine
+    MESSAGE_HANDLER message_handler;
+    PROGRESS_HANDLER progress_handler;
+    int progress_interval_ms;
+    bool cancelled;
+
+    // mesasge logging
+    void logMessage(QString message, MESSAGE_TYPE type = MESSAGE_INFO);
+    // generating the board
+    void fillGrid(val* grid);
+    bool fillCells(val* grid, int index, cmask* used);
+    void permuteGrid(const val* seed, val* grid);
+    void showClues();
+
+    // working with candidates
+    cmask computeCandidates(int,int) const;
+    void updateCandidates();
+    static const PEER_TABLE& peers();
+    static const UNIT_TABLE& units();
+    bool eliminateFromPeers(int row, int col, val value);
+
+    // backtracking
+    void saveCell(int row, int col);
+    void pushChoicePoint();
+    bool restoreChoicePoint();
+    int historyDepth() const;
+
+    // solve trace
+    void startTrace();
+
+    // solving
+    bool solveWithDeduction();
+    bool solveWithDlx();
+    bool solveWithBitboard();
+    bool solveFromCache(SudokuSolveCache::CACHE_KEY& key);
+    void writeSolution(const val* solution);
+    int countPuzzleSolutions(const val* puzzle, int limit);
+    STEP_RESULT deduction();
+    STEP_RESULT guessing();
+    bool isThereSomethingToGuess();
+    GUESS nextGuess();
+    STEP_RESULT solveCellsWithOneCandidate();
+    STEP_RESULT solveCellsInRow();
+    STEP_RESULT solveCellsInColumn();
+    STEP_RESULT solveCellsInBox();
+    STEP_RESULT eliminateWithTechniques();
+    void computeUnitPlaces(UNIT_PLACES& p) const;
+    bool eliminateCandidates(int index, cmask mask);
+    STEP_RESULT eliminateFromUnit(int u, quint32 keep, cmask mask, const char* technique);
+    bool solveCell(int, int, val);
+};
+
+typedef SudokuBoardT<SUDOKU_BOX_SIZE> SudokuBoard;
+typedef SudokuBoardT<4> SudokuBoard16;
+typedef SudokuBoardT<5> SudokuBoard25;
+
+#endif // SUDOKUBOARD_H
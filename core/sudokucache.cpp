@@ -0,0 +1,332 @@
+#include "sudokucache.h"
+#include <QMutexLocker>
+#include <vector>
+#include <cstring>
+
+namespace {
+
+// the 6^4 = 1296 column orders keeping the stacks: stack order, then the column order inside every stack
+#define COLUMN_ORDER_COUNT 1296
+
+// all column orders and, for every occupancy mask of a row, the smallest mask they give and the orders giving it
+// a row mask has bit (8-c) set when column c is occupied, so a smaller mask has its clues further right
+typedef struct {
+    quint8 cols[COLUMN_ORDER_COUNT][SUDOKU_BOARD_SIDE];
+    quint16 min_mask[1 << SUDOKU_BOARD_SIDE];
+    std::vector<quint16> min_orders[1 << SUDOKU_BOARD_SIDE];
+} COLUMN_ORDERS;
+
+const COLUMN_ORDERS& columnOrders()
+{
+    static const COLUMN_ORDERS* orders = [](){
+        static const quint8 perm3[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+        COLUMN_ORDERS* o = new COLUMN_ORDERS;
+        int n = 0;
+        for(int s=0; s<6; s++){
+            for(int a=0; a<6; a++){
+                for(int b=0; b<6; b++){
+                    for(int c=0; c<6; c++){
+                        const int inner[3] = {a, b, c};
+                        for(int k=0; k<SUDOKU_BOARD_SIDE; k++){
+                            int stack = perm3[s][k/3];
+                            o->cols[n][k] = quint8(stack*3+perm3[inner[k/3]][k%3]);
+                        }
+                        n++;
+                    }
+                }
+            }
+        }
+        for(int m=0; m<(1 << SUDOKU_BOARD_SIDE); m++){
+            quint16 best = 0xFFFF;
+            for(int p=0; p<COLUMN_ORDER_COUNT; p++){
+                quint16 pm = 0;
+                for(int k=0; k<SUDOKU_BOARD_SIDE; k++){
+                    if(m & (1 << (8-o->cols[p][k]))){
+                        pm |= quint16(1 << (8-k));
+                    }
+                }
+                if(pm < best){
+                    best = pm;
+                    o->min_orders[m].clear();
+                }
+                if(pm == best){
+                    o->min_orders[m].push_back(quint16(p));
+                }
+            }
+            o->min_mask[m] = best;
+        }
+        return o;
+    }();
+    return *orders;
+}
+
+// partial transform while searching: the first rows of the canonical board are chosen, the columns are fixed
+typedef struct {
+    bool transposed;
+    quint8 rows[SUDOKU_BOARD_SIDE];
+    quint16 order;      // index of the column order
+    val digits[SUDOKU_BOARD_SIDE+1];
+    val next_digit;     // label of the next digit seen for the first time
+} CANONICAL_STATE;
+
+} // namespace
+
+// function to compute the canonical form, see header
+// the rows of the canonical board are chosen one by one, keeping every partial transform that gives the smallest
+// rows so far; digits are labeled 1,2,3... in order of first appearance, so the transforms only differ by their
+// row and column orders, and the first row is minimized by its occupancy mask alone
+bool canonicalForm(const val* puzzle, val* canonical, BOARD_TRANSFORM* transform)
+{
+    const int N = SUDOKU_BOARD_SIDE;
+    int clues = 0;
+    for(int i=0; i<CELL_COUNT; i++){
+        clues += puzzle[i] != 0;
+    }
+    if(clues < CANONICAL_MIN_CLUES){
+        return false;
+    }
+    const COLUMN_ORDERS& orders = columnOrders();
+
+    val source[2][CELL_COUNT];
+    for(int r=0; r<N; r++){
+        for(int c=0; c<N; c++){
+            source[0][r*N+c] = puzzle[r*N+c];
+            source[1][r*N+c] = puzzle[c*N+r];
+        }
+    }
+
+    // first row: the lines with the smallest best mask, with every column order reaching it
+    quint16 line_mask[2][SUDOKU_BOARD_SIDE];
+    quint16 best_mask = 0xFFFF;
+    for(int t=0; t<2; t++){
+        for(int r=0; r<N; r++){
+            quint16 m = 0;
+            for(int c=0; c<N; c++){
+                if(source[t][r*N+c]){
+                    m |= quint16(1 << (8-c));
+                }
+            }
+            line_mask[t][r] = m;
+            best_mask = qMin(best_mask, orders.min_mask[m]);
+        }
+    }
+    std::vector<CANONICAL_STATE> states;
+    std::vector<CANONICAL_STATE> next_states;
+    for(int t=0; t<2; t++){
+        for(int r=0; r<N; r++){
+            quint16 m = line_mask[t][r];
+            if(orders.min_mask[m] != best_mask){
+                continue;
+            }
+            for(quint16 p : orders.min_orders[m]){
+                CANONICAL_STATE s;
+                s.transposed = t != 0;
+                s.rows[0] = quint8(r);
+                s.order = p;
+                memset(s.digits, 0, sizeof(s.digits));
+                s.next_digit = 1;
+                for(int c=0; c<N; c++){
+                    val v = source[t][r*N+orders.cols[p][c]];
+                    if(v && !s.digits[v]){
+                        s.digits[v] = s.next_digit++;
+                    }
+                }
+                states.push_back(s);
+            }
+        }
+    }
+    if(states.size() > CANONICAL_STATE_LIMIT){
+        return false;
+    }
+
+    // following rows: the free rows of the current band, or the rows of a free band every third row
+    for(int k=1; k<N; k++){
+        val best[SUDOKU_BOARD_SIDE];
+        for(int c=0; c<N; c++){
+            best[c] = val(N+1);
+        }
+        next_states.clear();
+        for(const CANONICAL_STATE& s : states){
+            int first = k-k%3;
+            for(int r=0; r<N; r++){
+                if(k%3 == 0){
+                    bool band_used = false;
+                    for(int j=0; j<k; j+=3){
+                        band_used |= s.rows[j]/3 == r/3;
+                    }
+                    if(band_used){
+                        continue;
+                    }
+                }
+                else{
+                    if(r/3 != s.rows[first]/3){
+                        continue;
+                    }
+                    bool row_used = false;
+                    for(int j=first; j<k; j++){
+                        row_used |= s.rows[j] == r;
+                    }
+                    if(row_used){
+                        continue;
+                    }
+                }
+
+                // the row relabeled, given up as soon as it is larger than the best one
+                CANONICAL_STATE n = s;
+                const val* line = source[s.transposed ? 1 : 0]+r*N;
+                const quint8* cols = orders.cols[s.order];
+                val row[SUDOKU_BOARD_SIDE];
+                bool smaller = false;
+                bool larger = false;
+                for(int c=0; c<N && !larger; c++){
+                    val v = line[cols[c]];
+                    if(v && !n.digits[v]){
+                        n.digits[v] = n.next_digit++;
+                    }
+                    row[c] = v ? n.digits[v] : 0;
+                    if(!smaller){
+                        larger = row[c] > best[c];
+                        smaller = row[c] < best[c];
+                    }
+                }
+                if(larger){
+                    continue;
+                }
+                if(smaller){
+                    memcpy(best, row, sizeof(best));
+                    next_states.clear();
+                }
+                n.rows[k] = quint8(r);
+                next_states.push_back(n);
+            }
+        }
+        if(next_states.size() > CANONICAL_STATE_LIMIT){
+            return false;
+        }
+        states.swap(next_states);
+    }
+
+    // every remaining state gives the same board, digits missing from the puzzle get the free labels in order
+    const CANONICAL_STATE& s = states.front();
+    transform->transposed = s.transposed;
+    for(int i=0; i<N; i++){
+        transform->rows[i] = s.rows[i];
+        transform->cols[i] = orders.cols[s.order][i];
+    }
+    memcpy(transform->digits, s.digits, sizeof(s.digits));
+    val next_digit = s.next_digit;
+    for(int v=1; v<=N; v++){
+        if(!transform->digits[v]){
+            transform->digits[v] = next_digit++;
+        }
+    }
+    applyTransform(*transform, puzzle, canonical);
+    return true;
+}
+
+// function to apply the transform to a board, see header
+void applyTransform(const BOARD_TRANSFORM& transform, const val* board, val* transformed)
+{
+    const int N = SUDOKU_BOARD_SIDE;
+    for(int r=0; r<N; r++){
+        for(int c=0; c<N; c++){
+            int i = transform.transposed ? transform.cols[c]*N+transform.rows[r] : transform.rows[r]*N+transform.cols[c];
+            transformed[r*N+c] = transform.digits[board[i]];
+        }
+    }
+}
+
+// function to undo the transform, see header
+void applyInverseTransform(const BOARD_TRANSFORM& transform, const val* transformed, val* board)
+{
+    const int N = SUDOKU_BOARD_SIDE;
+    val inverse[SUDOKU_BOARD_SIDE+1];
+    for(int v=0; v<=N; v++){
+        inverse[transform.digits[v]] = val(v);
+    }
+    for(int r=0; r<N; r++){
+        for(int c=0; c<N; c++){
+            int i = transform.transposed ? transform.cols[c]*N+transform.rows[r] : transform.rows[r]*N+transform.cols[c];
+            board[i] = inverse[transformed[r*N+c]];
+        }
+    }
+}
+
+SudokuSolveCache::SudokuSolveCache(int capacity) :
+    solutions(capacity),
+    hits(0),
+    misses(0)
+{
+}
+
+// function to compute the cache key of the puzzle
+SudokuSolveCache::CACHE_KEY SudokuSolveCache::key(const val* puzzle)
+{
+    CACHE_KEY k;
+    k.canonical.resize(CELL_COUNT);
+    if(!canonicalForm(puzzle, reinterpret_cast<val*>(k.canonical.data()), &k.transform)){
+        k.canonical.clear();
+    }
+    return k;
+}
+
+// function to write the solution of the keyed puzzle, returns false when no isomorphic puzzle was cached
+bool SudokuSolveCache::lookup(const CACHE_KEY& key, val* solution)
+{
+    if(key.canonical.isEmpty()){
+        return false;
+    }
+    QMutexLocker locker(&mutex);
+    const QByteArray* cached = solutions.object(key.canonical);
+    if(!cached){
+        misses++;
+        return false;
+    }
+    hits++;
+    applyInverseTransform(key.transform, reinterpret_cast<const val*>(cached->constData()), solution);
+    return true;
+}
+
+// function to remember the solution of the keyed puzzle, the least recently used solution is dropped when full
+void SudokuSolveCache::insert(const CACHE_KEY& key, const val* solution)
+{
+    if(key.canonical.isEmpty()){
+        return;
+    }
+    QByteArray* canonical_solution = new QByteArray(CELL_COUNT, 0);
+    applyTransform(key.transform, solution, reinterpret_cast<val*>(canonical_solution->data()));
+    QMutexLocker locker(&mutex);
+    solutions.insert(key.canonical, canonical_solution);
+}
+
+void SudokuSolveCache::setCapacity(int capacity)
+{
+    QMutexLocker locker(&mutex);
+    solutions.setMaxCost(capacity);
+}
+
+int SudokuSolveCache::count() const
+{
+    QMutexLocker locker(&mutex);
+    return solutions.count();
+}
+
+void SudokuSolveCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    solutions.clear();
+    hits = 0;
+    misses = 0;
+}
+
+qint64 SudokuSolveCache::getHits() const
+{
+    QMutexLocker locker(&mutex);
+    return hits;
+}
+
+qint64 SudokuSolveCache::getMisses() const
+{
+    QMutexLocker locker(&mutex);
+    return misses;
+}
@@ -0,0 +1,72 @@
+#ifndef SUDOKUCACHE_H
+#define SUDOKUCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include "sudokutypes.h"
+
+// solutions kept by SudokuSolveCache by default, about 200 bytes each
+#define SOLVE_CACHE_CAPACITY 100000
+
+// puzzles with fewer clues (none of them has a unique solution) are not canonicalized,
+// nearly empty boards have millions of equally small partial transforms
+#define CANONICAL_MIN_CLUES 17
+// partial transforms kept by the canonical form search at most, more give up the search (about 24 bytes each)
+#define CANONICAL_STATE_LIMIT 20000
+
+// symmetry of the 9x9 board: cell (r,c) of the transformed board is cell (rows[r],cols[c]) of the
+// original board (read transposed when 'transposed') with its value relabeled by digits[]
+typedef struct {
+    bool transposed;
+    quint8 rows[SUDOKU_BOARD_SIDE];
+    quint8 cols[SUDOKU_BOARD_SIDE];
+    val digits[SUDOKU_BOARD_SIDE+1];    // digits[original value] = new value, digits[0] = 0
+} BOARD_TRANSFORM;
+
+// function to compute the canonical form of a 9x9 puzzle (CELL_COUNT values, 0 for empty cells)
+// the canonical form is the lexicographically smallest board reachable by the 2*6^8*9! symmetries
+// (transposition, band/row and stack/column permutations, digit relabeling), so isomorphic puzzles have the same one
+// returns false without a result for puzzles with fewer than CANONICAL_MIN_CLUES clues and when the search
+// exceeds CANONICAL_STATE_LIMIT partial transforms (very symmetric puzzles)
+bool canonicalForm(const val* puzzle, val* canonical, BOARD_TRANSFORM* transform);
+
+// function to apply the transform to a board, 'board' and 'transformed' must not overlap
+void applyTransform(const BOARD_TRANSFORM& transform, const val* board, val* transformed);
+
+// function to undo the transform, applyInverseTransform(t, applyTransform(t, b)) is b
+void applyInverseTransform(const BOARD_TRANSFORM& transform, const val* transformed, val* board);
+
+// LRU cache of solved 9x9 puzzles keyed by their canonical form, a puzzle isomorphic to a cached one
+// is answered with the cached solution mapped back through the puzzle's transform
+// lookup() and insert() may be called from several threads
+class SudokuSolveCache
+{
+public:
+    // canonical form of a puzzle and the transform to it, computed once and used for lookup and insert
+    // 'canonical' is empty when the puzzle has no canonical form, lookup() and insert() skip such puzzles
+    typedef struct {
+        QByteArray canonical;
+        BOARD_TRANSFORM transform;
+    } CACHE_KEY;
+
+    SudokuSolveCache(int capacity = SOLVE_CACHE_CAPACITY);
+
+    static CACHE_KEY key(const val* puzzle);
+    bool lookup(const CACHE_KEY& key, val* solution);
+    void insert(const CACHE_KEY& key, const val* solution);
+
+    void setCapacity(int capacity);
+    int count() const;
+    void clear();
+    qint64 getHits() const;
+    qint64 getMisses() const;
+
+private:
+    mutable QMutex mutex;
+    QCache<QByteArray, QByteArray> solutions; // canonical puzzle -> solution of the canonical puzzle
+    qint64 hits;
+    qint64 misses;
+};
+
+#endif // SUDOKUCACHE_H
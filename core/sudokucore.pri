@@ -0,0 +1,14 @@
+# include this file in a project that links the headless solver library
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): SUDOKUCORE_DIR = $$OUT_PWD/../core/release
+else:win32:CONFIG(debug, debug|release): SUDOKUCORE_DIR = $$OUT_PWD/../core/debug
+else: SUDOKUCORE_DIR = $$OUT_PWD/../core
+
+LIBS += -L$$SUDOKUCORE_DIR -lsudokucore
+
+win32-g++: PRE_TARGETDEPS += $$SUDOKUCORE_DIR/libsudokucore.a
+else:win32:!win32-g++: PRE_TARGETDEPS += $$SUDOKUCORE_DIR/sudokucore.lib
+else: PRE_TARGETDEPS += $$SUDOKUCORE_DIR/libsudokucore.a
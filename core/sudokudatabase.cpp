@@ -0,0 +1,268 @@
+#include "sudokudatabase.h"
+#include <QtEndian>
+#include <cstring>
+
+// header field offsets
+#define DB_OFFSET_VERSION 8
+#define DB_OFFSET_BOX_SIZE 12
+#define DB_OFFSET_COLUMNS 16
+#define DB_OFFSET_RECORD_SIZE 20
+#define DB_OFFSET_COUNT 24
+
+// function to check the header, returns the error or an empty string
+static QString checkHeader(const uchar* header, qint64 file_size)
+{
+    if(file_size < SUDOKU_DB_HEADER_SIZE || memcmp(header, SUDOKU_DB_MAGIC, 8) != 0){
+        return "not a puzzle database";
+    }
+    if(qFromLittleEndian<quint32>(header+DB_OFFSET_VERSION) != SUDOKU_DB_VERSION){
+        return "unsupported database version";
+    }
+    if(qFromLittleEndian<quint32>(header+DB_OFFSET_BOX_SIZE) != SUDOKU_BOX_SIZE){
+        return "unsupported box size";
+    }
+    int columns = int(qFromLittleEndian<quint32>(header+DB_OFFSET_COLUMNS));
+    if(int(qFromLittleEndian<quint32>(header+DB_OFFSET_RECORD_SIZE)) != databaseRecordSize(columns)){
+        return "corrupted database header";
+    }
+    return QString();
+}
+
+// function to return the number of complete records in the file
+// the count in the header is only updated by flush() and close(), it lags behind the records written since
+// and stays 0 when the writer was interrupted, so the records are counted by the file size instead
+static qint64 recordCount(const uchar* header, qint64 file_size)
+{
+    int record_size = int(qFromLittleEndian<quint32>(header+DB_OFFSET_RECORD_SIZE));
+    return (file_size-SUDOKU_DB_HEADER_SIZE)/record_size;
+}
+
+SudokuDatabase::SudokuDatabase() :
+    records(nullptr),
+    record_count(0),
+    columns(DB_PUZZLES),
+    record_size(databaseRecordSize(DB_PUZZLES))
+{
+}
+
+SudokuDatabase::~SudokuDatabase()
+{
+    close();
+}
+
+// function to open the database and map it into memory, nothing is read until records are accessed
+bool SudokuDatabase::open(const QString& path)
+{
+    close();
+    file.setFileName(path);
+    if(!file.open(QIODevice::ReadOnly)){
+        error = file.errorString();
+        return false;
+    }
+    qint64 size = file.size();
+    const uchar* map = size >= SUDOKU_DB_HEADER_SIZE ? file.map(0, size) : nullptr;
+    error = map ? checkHeader(map, size) : (size < SUDOKU_DB_HEADER_SIZE ? QString("not a puzzle database") : file.errorString());
+    if(!error.isEmpty()){
+        file.close();
+        return false;
+    }
+    columns = int(qFromLittleEndian<quint32>(map+DB_OFFSET_COLUMNS));
+    record_size = databaseRecordSize(columns);
+    record_count = recordCount(map, size);
+    records = map+SUDOKU_DB_HEADER_SIZE;
+    return true;
+}
+
+// function to unmap and close the database, record pointers become invalid
+void SudokuDatabase::close()
+{
+    file.close();
+    records = nullptr;
+    record_count = 0;
+}
+
+bool SudokuDatabase::isOpen() const
+{
+    return records != nullptr;
+}
+
+QString SudokuDatabase::getError() const
+{
+    return error;
+}
+
+// function to return true if the file starts with the database magic
+bool SudokuDatabase::isDatabase(const QString& path)
+{
+    QFile f(path);
+    return f.open(QIODevice::ReadOnly) && f.read(8) == QByteArray(SUDOKU_DB_MAGIC);
+}
+
+qint64 SudokuDatabase::count() const
+{
+    return record_count;
+}
+
+int SudokuDatabase::getColumns() const
+{
+    return columns;
+}
+
+int SudokuDatabase::getRecordSize() const
+{
+    return record_size;
+}
+
+// function to return the packed record in the memory map
+const uchar* SudokuDatabase::record(qint64 index) const
+{
+    return records+index*record_size;
+}
+
+// function to unpack the puzzle of the record
+void SudokuDatabase::readPuzzle(qint64 index, val* puzzle) const
+{
+    SudokuBoard::unpackBoards(record(index), 1, puzzle);
+}
+
+// function to unpack the solution of the record, returns false when the database has no solutions
+bool SudokuDatabase::readSolution(qint64 index, val* solution) const
+{
+    if(!(columns & DB_SOLUTIONS)){
+        return false;
+    }
+    SudokuBoard::unpackBoards(record(index)+SUDOKU_DB_PACKED_SIZE, 1, solution);
+    return true;
+}
+
+// function to return the rating of the record, -1 when the database has no ratings or the rating is unknown
+double SudokuDatabase::readRating(qint64 index) const
+{
+    if(!(columns & DB_RATINGS)){
+        return -1;
+    }
+    uchar r = record(index)[record_size-1];
+    return r == SUDOKU_DB_NO_RATING ? -1 : r/10.0;
+}
+
+SudokuDatabaseWriter::SudokuDatabaseWriter() :
+    columns(DB_PUZZLES),
+    record_size(databaseRecordSize(DB_PUZZLES)),
+    record_count(0)
+{
+}
+
+SudokuDatabaseWriter::~SudokuDatabaseWriter()
+{
+    close();
+}
+
+// function to create the database, or to append to it when it exists
+// an existing database must have the same columns, an unfinished last record is dropped
+bool SudokuDatabaseWriter::open(const QString& path, int c)
+{
+    close();
+    columns = c;
+    record_size = databaseRecordSize(columns);
+    record_count = 0;
+    file.setFileName(path);
+    if(!file.open(QIODevice::ReadWrite)){
+        error = file.errorString();
+        return false;
+    }
+    if(file.size() == 0){
+        return writeHeader();
+    }
+
+    QByteArray header = file.read(SUDOKU_DB_HEADER_SIZE);
+    const uchar* h = reinterpret_cast<const uchar*>(header.constData());
+    error = checkHeader(h, file.size());
+    if(error.isEmpty() && int(qFromLittleEndian<quint32>(h+DB_OFFSET_COLUMNS)) != columns){
+        error = "the database has other columns";
+    }
+    if(!error.isEmpty()){
+        file.close();
+        return false;
+    }
+    record_count = recordCount(h, file.size());
+    if(!file.resize(SUDOKU_DB_HEADER_SIZE+record_count*record_size)){
+        error = file.errorString();
+        file.close();
+        return false;
+    }
+    return file.seek(file.size());
+}
+
+// function to append one record, the rating is optional (-1 is unknown)
+bool SudokuDatabaseWriter::append(const val* puzzle, const val* solution, double rating)
+{
+    uchar buffer[2*SUDOKU_DB_PACKED_SIZE+1];
+    SudokuBoard::packBoards(puzzle, 1, buffer);
+    int size = SUDOKU_DB_PACKED_SIZE;
+    if(columns & DB_SOLUTIONS){
+        if(solution){
+            SudokuBoard::packBoards(solution, 1, buffer+size);
+        }
+        else{
+            memset(buffer+size, 0, SUDOKU_DB_PACKED_SIZE);
+        }
+        size += SUDOKU_DB_PACKED_SIZE;
+    }
+    if(columns & DB_RATINGS){
+        buffer[size++] = rating < 0 ? uchar(SUDOKU_DB_NO_RATING) : uchar(qBound(0, qRound(rating*10), 254));
+    }
+    if(file.write(reinterpret_cast<const char*>(buffer), size) != size){
+        error = file.errorString();
+        return false;
+    }
+    record_count++;
+    return true;
+}
+
+// function to write the record count into the header and the buffered records to disk
+bool SudokuDatabaseWriter::flush()
+{
+    if(!file.isOpen()){
+        return false;
+    }
+    return writeHeader() && file.flush();
+}
+
+// function to finish the database, returns false if it could not be completed
+bool SudokuDatabaseWriter::close()
+{
+    if(!file.isOpen()){
+        return true;
+    }
+    bool ok = flush();
+    file.close();
+    return ok;
+}
+
+qint64 SudokuDatabaseWriter::count() const
+{
+    return record_count;
+}
+
+QString SudokuDatabaseWriter::getError() const
+{
+    return error;
+}
+
+// function to write the header and return to the end of the records
+bool SudokuDatabaseWriter::writeHeader()
+{
+    uchar header[SUDOKU_DB_HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    memcpy(header, SUDOKU_DB_MAGIC, 8);
+    qToLittleEndian<quint32>(SUDOKU_DB_VERSION, header+DB_OFFSET_VERSION);
+    qToLittleEndian<quint32>(SUDOKU_BOX_SIZE, header+DB_OFFSET_BOX_SIZE);
+    qToLittleEndian<quint32>(quint32(columns), header+DB_OFFSET_COLUMNS);
+    qToLittleEndian<quint32>(quint32(record_size), header+DB_OFFSET_RECORD_SIZE);
+    qToLittleEndian<quint64>(quint64(record_count), header+DB_OFFSET_COUNT);
+    if(!file.seek(0) || file.write(reinterpret_cast<const char*>(header), sizeof(header)) != qint64(sizeof(header))){
+        error = file.errorString();
+        return false;
+    }
+    return file.seek(SUDOKU_DB_HEADER_SIZE+record_count*record_size);
+}
@@ -0,0 +1,97 @@
+#ifndef SUDOKUDATABASE_H
+#define SUDOKUDATABASE_H
+
+#include <QFile>
+#include <QString>
+#include "sudokuboard.h"
+
+// binary database of 9x9 puzzles: a header followed by fixed-size records, so record i is found without reading
+// the records before it; the file is read through a memory map and only the touched pages are loaded
+//
+// header (little-endian, SUDOKU_DB_HEADER_SIZE bytes):
+//   char magic[8] "SUDOKUDB", quint32 version, quint32 box size (3), quint32 columns (DB_COLUMN flags),
+//   quint32 record size, quint64 record count, zero padding
+// record:
+//   puzzle in the packed form of SudokuBoard::packBoards(), 4 bits per cell: cell 2i in the low and cell 2i+1
+//   in the high nibble of byte i, 0 is an empty cell
+//   solution in the same form (DB_SOLUTIONS)
+//   rating times ten, 0..100, or 255 when unknown (DB_RATINGS)
+#define SUDOKU_DB_MAGIC "SUDOKUDB"
+#define SUDOKU_DB_VERSION 1
+#define SUDOKU_DB_HEADER_SIZE 64
+#define SUDOKU_DB_PACKED_SIZE int(SudokuBoard::PACKED_SIZE)
+#define SUDOKU_DB_NO_RATING 255
+
+// optional columns of the records, the puzzle is always stored
+typedef enum {
+    DB_PUZZLES = 0,
+    DB_SOLUTIONS = 1,
+    DB_RATINGS = 2
+} DB_COLUMN;
+
+// read-only access to a puzzle database through a memory map, records are read in place without copying
+// the reader may be shared by several threads once it is open
+class SudokuDatabase
+{
+public:
+    SudokuDatabase();
+    ~SudokuDatabase();
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const;
+    QString getError() const;
+    static bool isDatabase(const QString& path);
+
+    qint64 count() const;
+    int getColumns() const;
+    int getRecordSize() const;
+
+    // records, 'index' is 0..count()-1
+    const uchar* record(qint64 index) const;
+    void readPuzzle(qint64 index, val* puzzle) const;
+    bool readSolution(qint64 index, val* solution) const;
+    double readRating(qint64 index) const;
+
+private:
+    QFile file;
+    const uchar* records;
+    qint64 record_count;
+    int columns;
+    int record_size;
+    QString error;
+};
+
+// writer appending records to a new or an existing puzzle database
+// the record count in the header is updated by flush() and close(), readers count the records by the file size,
+// so the records of an interrupted writer are kept
+class SudokuDatabaseWriter
+{
+public:
+    SudokuDatabaseWriter();
+    ~SudokuDatabaseWriter();
+
+    bool open(const QString& path, int columns);
+    bool append(const val* puzzle, const val* solution = nullptr, double rating = -1);
+    bool flush();
+    bool close();
+    qint64 count() const;
+    QString getError() const;
+
+private:
+    QFile file;
+    int columns;
+    int record_size;
+    qint64 record_count;
+    QString error;
+
+    bool writeHeader();
+};
+
+// function to return the size of a record with the columns
+inline int databaseRecordSize(int columns)
+{
+    return SUDOKU_DB_PACKED_SIZE*((columns & DB_SOLUTIONS) ? 2 : 1)+((columns & DB_RATINGS) ? 1 : 0);
+}
+
+#endif // SUDOKUDATABASE_H
@@ -0,0 +1,23 @@
+#ifndef SUDOKUGRID_H
+#define SUDOKUGRID_H
+
+// board geometry and cell values shared by all solver engines
+// the macros describe the classic 9x9 board, larger boards use SudokuGeometry
+// plain C++ without Qt, so that code compiled with another instruction set (the AVX2 kernel) can include it
+
+typedef unsigned char val;
+
+// candidate bitmask, bit (v-1) is set when value 'v' is a candidate
+typedef unsigned short cmask;
+
+#define SUDOKU_BOARD_SIDE 9
+#define SUDOKU_BOX_SIZE 3
+#define CLUES_COUNT 30
+#define CANDIDATE_COUNT 9
+#define CELL_COUNT (SUDOKU_BOARD_SIDE*SUDOKU_BOARD_SIDE)
+#define PEER_COUNT (2*(SUDOKU_BOARD_SIDE-1)+(SUDOKU_BOX_SIZE-1)*(SUDOKU_BOX_SIZE-1))
+
+#define DEFAULT_CANDIDATES cmask((1u << CANDIDATE_COUNT) - 1)
+#define NO_CANDIDATES cmask(0)
+
+#endif // SUDOKUGRID_H
@@ -0,0 +1,69 @@
+#ifndef SUDOKURANDOM_H
+#define SUDOKURANDOM_H
+
+#include <QtGlobal>
+
+// small and fast pseudo random generator (xoshiro256**) used by the board generator
+// the same seed always gives the same sequence, so generated boards are reproducible
+class SudokuRandom
+{
+public:
+    SudokuRandom(quint64 seed = 0)
+    {
+        setSeed(seed);
+    }
+
+    // function to restart the sequence, the state is expanded from the seed with splitmix64
+    void setSeed(quint64 seed)
+    {
+        for(int i=0; i<4; i++){
+            seed += 0x9E3779B97F4A7C15ull;
+            quint64 z = seed;
+            z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27))*0x94D049BB133111EBull;
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    // function to return the next 64 random bits
+    quint64 next()
+    {
+        quint64 result = rotate(state[1]*5, 7)*9;
+        quint64 t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+        return result;
+    }
+
+    // function to return a random number in [0,n), multiply-shift instead of the slow modulo
+    int bounded(int n)
+    {
+        return int((quint64(quint32(next() >> 32))*quint32(n)) >> 32);
+    }
+
+    // function to shuffle 'count' items (Fisher-Yates)
+    template<class T>
+    void shuffle(T* items, int count)
+    {
+        for(int i=count-1; i>0; i--){
+            int j = bounded(i+1);
+            T t = items[i];
+            items[i] = items[j];
+            items[j] = t;
+        }
+    }
+
+private:
+    quint64 state[4];
+
+    static quint64 rotate(quint64 x, int k)
+    {
+        return (x << k) | (x >> (64-k));
+    }
+};
+
+#endif // SUDOKURANDOM_H
@@ -0,0 +1,198 @@
+#include "sudokuservice.h"
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+// engine names of the requests, in SOLVER_ENGINE order
+static const char* const engine_names[] = {"deduction", "dlx", "bitboard"};
+
+// constructor, 'threads' 0 uses all cores, the workers wait for requests until the service is destroyed
+SudokuService::SudokuService(int threads) :
+    thread_count(threads > 0 ? threads : qMax(1, QThread::idealThreadCount())),
+    engine(ENGINE_DEDUCTION),
+    solve_cache(nullptr),
+    busy(0),
+    stopping(false)
+{
+    for(int i=0; i<thread_count; i++){
+        workers.emplace_back(&SudokuService::work, this);
+    }
+}
+
+// destructor, the queued requests are still answered
+SudokuService::~SudokuService()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    work_ready.notify_all();
+    for(std::thread& w : workers){
+        w.join();
+    }
+}
+
+// function to return the number of worker threads
+int SudokuService::getThreadCount() const
+{
+    return thread_count;
+}
+
+// function to select the engine of requests that do not name one
+void SudokuService::setEngine(SOLVER_ENGINE e)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    engine = e;
+}
+
+// function to share a solve cache between the boards of all workers, nullptr (default) turns it off
+void SudokuService::setSolveCache(SudokuSolveCache* cache)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    solve_cache = cache;
+}
+
+// function to queue one request, 'handler' is called with its response
+// waits while SERVICE_QUEUE_LIMIT requests are queued, so a fast producer does not grow the queue without bound
+void SudokuService::submit(const QByteArray& request, RESPONSE_HANDLER handler)
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        queue_space.wait(guard, [this](){ return queue.size() < SERVICE_QUEUE_LIMIT; });
+        queue.push_back({request, handler});
+    }
+    work_ready.notify_one();
+}
+
+// function to queue several requests at once, 'handler' is called with the response of each
+// waits for room in the queue like the single request submit()
+void SudokuService::submit(const QVector<QByteArray>& requests, RESPONSE_HANDLER handler)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    for(const QByteArray& request : requests){
+        queue_space.wait(guard, [this](){ return queue.size() < SERVICE_QUEUE_LIMIT; });
+        queue.push_back({request, handler});
+        work_ready.notify_one();
+    }
+}
+
+// function to wait until every queued request is answered
+void SudokuService::waitForIdle()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    work_done.wait(guard, [this](){ return queue.empty() && busy == 0; });
+}
+
+// function run by every worker thread: take the next request, answer it on the worker's board
+// one request per lock, the lock is short next to a solve and an idle worker never waits behind a slow request
+void SudokuService::work()
+{
+    SudokuBoard board;
+    SOLVER_ENGINE default_engine;
+    while(true){
+        SERVICE_REQUEST r;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            work_ready.wait(guard, [this](){ return !queue.empty() || stopping; });
+            if(queue.empty()){
+                return;
+            }
+            r = std::move(queue.front());
+            queue.pop_front();
+            busy++;
+            default_engine = engine;
+            board.setSolveCache(solve_cache);
+        }
+        queue_space.notify_one();
+        r.handler(answer(r.request, board, default_engine));
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            busy--;
+            if(queue.empty() && busy == 0){
+                work_done.notify_all();
+            }
+        }
+    }
+}
+
+// function to answer one request on the board, see the class comment for the format
+QByteArray SudokuService::answer(const QByteArray& request, SudokuBoard& board, SOLVER_ENGINE default_engine)
+{
+    QJsonObject response;
+    QJsonParseError parse_error;
+    QJsonDocument document = QJsonDocument::fromJson(request, &parse_error);
+    const QJsonObject r = document.object();
+    if(r.contains("id")){
+        response["id"] = r["id"];
+    }
+
+    SOLVER_ENGINE engine = default_engine;
+    QString engine_name = r["engine"].toString();
+    for(int e=ENGINE_DEDUCTION; e<=ENGINE_BITBOARD; e++){
+        if(engine_name == engine_names[e]){
+            engine = SOLVER_ENGINE(e);
+        }
+    }
+    QByteArray puzzle = r["puzzle"].toString().toLatin1();
+
+    if(!document.isObject()){
+        response["status"] = "error";
+        response["error"] = parse_error.error != QJsonParseError::NoError ? parse_error.errorString() : QString("the request is not a JSON object");
+    }
+    else if(!engine_name.isEmpty() && engine_name != engine_names[engine]){
+        response["status"] = "error";
+        response["error"] = "unknown engine " + engine_name;
+    }
+    else if(puzzle.size() != CELL_COUNT || !board.loadString(puzzle.constData())){
+        response["status"] = "invalid";
+    }
+    else if(r["rate"].toBool()){
+        QElapsedTimer timer;
+        timer.start();
+        DIFFICULTY_RATING rating = board.rate();
+        response["status"] = rating.valid ? "rated" : "unsolvable";
+        response["microseconds"] = double(timer.nsecsElapsed()/1000);
+        response["rating"] = rating.rating;
+        response["techniques"] = SudokuBoard::formatRating(rating);
+    }
+    else{
+        int timeout_ms = r["timeout_ms"].toInt();
+        qint64 max_guesses = qint64(r["max_guesses"].toDouble());
+        QElapsedTimer timer;
+        timer.start();
+        if(timeout_ms > 0 || max_guesses > 0){
+            board.setProgressHandler([&timer, timeout_ms, max_guesses](const SOLVE_PROGRESS& progress){
+                return (timeout_ms <= 0 || timer.elapsed() < timeout_ms) && (max_guesses <= 0 || progress.guesses < max_guesses);
+            }, SERVICE_PROGRESS_INTERVAL_MS);
+        }
+        board.setEngine(engine);
+        bool ok = board.solve();
+        board.setProgressHandler(nullptr);
+
+        if(board.wasCancelled()){
+            response["status"] = "timeout";
+        }
+        else if(ok){
+            char solution[CELL_COUNT];
+            board.writeString(solution);
+            response["status"] = "solved";
+            response["solution"] = QString::fromLatin1(solution, CELL_COUNT);
+        }
+        else{
+            response["status"] = "unsolvable";
+        }
+        const SOLVE_STATS& stats = board.getStats();
+        QJsonObject s;
+        s["guesses"] = double(board.getGuessCount());
+        s["backtracks"] = double(board.getBacktrackCount());
+        // only the deduction engine tracks the guess depth
+        if(engine == ENGINE_DEDUCTION){
+            s["max_depth"] = stats.max_depth;
+        }
+        s["cache_hit"] = stats.cache_hits > 0;
+        response["microseconds"] = double(timer.nsecsElapsed()/1000);
+        response["stats"] = s;
+    }
+    return QJsonDocument(response).toJson(QJsonDocument::Compact)+'\n';
+}
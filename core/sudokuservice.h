@@ -0,0 +1,73 @@
+#ifndef SUDOKUSERVICE_H
+#define SUDOKUSERVICE_H
+
+#include "sudokuboard.h"
+#include <QByteArray>
+#include <QVector>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// requests waiting in the queue at most, submit() blocks while the queue is full
+#define SERVICE_QUEUE_LIMIT 1024
+
+// how often a solve checks its limits
+#define SERVICE_PROGRESS_INTERVAL_MS 10
+
+// resident solver answering JSON requests, one JSON object per line:
+//   {"id": any, "puzzle": "<81 characters>", "engine": "deduction|dlx|bitboard", "rate": false,
+//    "timeout_ms": 0, "max_guesses": 0}
+// only "puzzle" is required, the engine defaults to setEngine(), limits of 0 are off and are checked
+// every SERVICE_PROGRESS_INTERVAL_MS
+// every request gets one response line, in the order the requests finish, matched to its request by "id":
+//   {"id": any, "status": "solved|unsolvable|invalid|timeout|error", "solution": "<81 characters>",
+//    "microseconds": n, "stats": {"guesses": n, "backtracks": n, "max_depth": n, "cache_hit": bool}}
+// "max_depth" is only reported by the deduction engine, the other engines do not track the depth of their guesses
+// "timeout" means a limit stopped the solve; with "rate" the status is "rated" or "unsolvable" and the response
+// has "rating" and "techniques" instead of "solution" and "stats", with "error" it has the "error" message
+// requests are solved by a pool of worker threads, each keeping its board between requests and taking
+// one request at a time, so a slow request holds back no other
+class SudokuService
+{
+public:
+    // called with the response line (ending with '\n') on the worker thread that solved the request
+    typedef std::function<void(const QByteArray& response)> RESPONSE_HANDLER;
+
+    SudokuService(int threads = 0);
+    ~SudokuService();
+
+    int getThreadCount() const;
+    void setEngine(SOLVER_ENGINE engine);
+    void setSolveCache(SudokuSolveCache* cache);
+    void submit(const QByteArray& request, RESPONSE_HANDLER handler);
+    void submit(const QVector<QByteArray>& requests, RESPONSE_HANDLER handler);
+    void waitForIdle();
+
+    // function to answer one request on the board, used by the workers
+    static QByteArray answer(const QByteArray& request, SudokuBoard& board, SOLVER_ENGINE default_engine = ENGINE_DEDUCTION);
+
+private:
+    typedef struct {
+        QByteArray request;
+        RESPONSE_HANDLER handler;
+    } SERVICE_REQUEST;
+
+    int thread_count;
+    SOLVER_ENGINE engine;
+    SudokuSolveCache* solve_cache;
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::condition_variable queue_space;
+    std::deque<SERVICE_REQUEST> queue;
+    int busy;           // requests taken by the workers and not answered yet
+    bool stopping;
+
+    void work();
+};
+
+#endif // SUDOKUSERVICE_H
@@ -0,0 +1,231 @@
+#ifndef SUDOKUTRACE_H
+#define SUDOKUTRACE_H
+
+#include <QVector>
+#include "sudokutypes.h"
+
+// kind of a recorded solve step
+// * TRACE_PLACE - value placed in the cell, the value is also removed from the candidates of the cell's peers
+// * TRACE_ELIMINATE - candidate removed from the cell by an elimination technique
+// * TRACE_GUESS - choice point saved, the next TRACE_PLACE is the guessed value
+// * TRACE_BACKTRACK - board returned to the state saved by the last TRACE_GUESS
+typedef enum {
+    TRACE_PLACE,
+    TRACE_ELIMINATE,
+    TRACE_GUESS,
+    TRACE_BACKTRACK
+} TRACE_EVENT;
+
+// steps recorded per solve at most (16 MB), longer solves keep the beginning and are marked truncated
+#define TRACE_LIMIT (1 << 22)
+// steps between two states saved by the replay, a seek applies at most this many steps
+#define TRACE_KEYFRAME_INTERVAL 1024
+
+// one step packed in 32 bits: event in bits 0-1, cell index (row*SIDE+col) in bits 2-11, value in bits 12-16
+inline quint32 packTraceStep(TRACE_EVENT event, int index, val value){ return quint32(event) | quint32(index) << 2 | quint32(value) << 12; }
+inline TRACE_EVENT traceEvent(quint32 step){ return TRACE_EVENT(step & 3); }
+inline int traceIndex(quint32 step){ return int((step >> 2) & 0x3FF); }
+inline val traceValue(quint32 step){ return val((step >> 12) & 0x1F); }
+
+// solve trace of a board with BOX_SIZE x BOX_SIZE boxes: the cells when solving started and every step after,
+// recording appends one word per step so it runs at solver speed, the replay is done by SudokuTracePlayerT
+template<int BOX_SIZE>
+class SudokuTraceT
+{
+public:
+    enum {
+        BOX = BOX_SIZE,
+        SIDE = BOX_SIZE*BOX_SIZE,
+        CELLS = SIDE*SIDE
+    };
+    typedef typename SudokuGeometry<BOX_SIZE>::MASK cmask;
+
+    // what the replay shows in one cell, value 0 is an unrevealed cell
+    typedef struct {
+        val value;
+        cmask candidates;
+    } TRACE_CELL;
+
+    SudokuTraceT() :
+        recording(false),
+        truncated(false)
+    {
+    }
+
+    // function to forget the steps and start recording from the cells
+    void start(const QVector<TRACE_CELL>& cells)
+    {
+        start_cells = cells;
+        steps.clear();
+        truncated = false;
+        recording = true;
+    }
+
+    // function to stop recording, the recorded steps are kept
+    void stop()
+    {
+        recording = false;
+    }
+
+    // function to forget the trace
+    void clear()
+    {
+        start_cells.clear();
+        steps.clear();
+        truncated = false;
+        recording = false;
+    }
+
+    bool isRecording() const { return recording; }
+
+    // function to append one step
+    void record(TRACE_EVENT event, int index, val value)
+    {
+        if(steps.count() >= TRACE_LIMIT){
+            truncated = true;
+            return;
+        }
+        steps.push_back(packTraceStep(event, index, value));
+    }
+
+    bool isEmpty() const { return start_cells.isEmpty(); }
+    bool isTruncated() const { return truncated; }
+    int count() const { return steps.count(); }
+    quint32 step(int i) const { return steps[i]; }
+    const QVector<TRACE_CELL>& getStartCells() const { return start_cells; }
+
+private:
+    QVector<TRACE_CELL> start_cells;
+    QVector<quint32> steps;
+    bool recording;
+    bool truncated;
+};
+
+// replay of a SudokuTraceT, seek() moves to any step in both directions
+// the state before every TRACE_KEYFRAME_INTERVAL-th step is saved by setTrace(), so a seek loads the keyframe
+// at or before the step and applies the rest; saved choice points are implicitly shared between keyframes
+template<int BOX_SIZE>
+class SudokuTracePlayerT
+{
+public:
+    typedef SudokuTraceT<BOX_SIZE> TRACE;
+    typedef typename TRACE::TRACE_CELL TRACE_CELL;
+    typedef typename TRACE::cmask cmask;
+
+    SudokuTracePlayerT() :
+        trace(nullptr),
+        position(0)
+    {
+    }
+
+    // function to replay the trace from its start, nullptr stops the replay
+    // the trace must stay alive and unchanged while it is replayed
+    void setTrace(const TRACE* t)
+    {
+        trace = t;
+        keyframes.clear();
+        position = 0;
+        if(!trace){
+            cells.clear();
+            choice_points.clear();
+            return;
+        }
+        rewind();
+        for(int i=0; i<trace->count(); i++){
+            if(i%TRACE_KEYFRAME_INTERVAL == 0){
+                keyframes.push_back({cells, choice_points});
+            }
+            apply(trace->step(i));
+        }
+        position = trace->count();
+        seek(0);
+    }
+
+    // function to show the board after the first 'step' steps
+    void seek(int step)
+    {
+        if(!trace){
+            return;
+        }
+        step = qBound(0, step, trace->count());
+        // the last step has no keyframe of its own when the count is a multiple of the interval
+        int keyframe = qMin(step/TRACE_KEYFRAME_INTERVAL, keyframes.count()-1);
+        if(step < position || position/TRACE_KEYFRAME_INTERVAL < keyframe){
+            if(keyframe >= 0){
+                cells = keyframes[keyframe].cells;
+                choice_points = keyframes[keyframe].choice_points;
+                position = keyframe*TRACE_KEYFRAME_INTERVAL;
+            }
+            else{
+                rewind();
+            }
+        }
+        while(position < step){
+            apply(trace->step(position++));
+        }
+    }
+
+    int getPosition() const { return position; }
+    int count() const { return trace ? trace->count() : 0; }
+    bool isEmpty() const { return cells.isEmpty(); }
+    const TRACE_CELL& getCell(int index) const { return cells[index]; }
+
+    // function to return the last applied step, the caller checks getPosition() > 0
+    quint32 lastStep() const { return trace->step(position-1); }
+
+private:
+    typedef struct {
+        QVector<TRACE_CELL> cells;
+        QVector<QVector<TRACE_CELL>> choice_points;
+    } KEYFRAME;
+
+    const TRACE* trace;
+    QVector<TRACE_CELL> cells;
+    QVector<QVector<TRACE_CELL>> choice_points;
+    QVector<KEYFRAME> keyframes;
+    int position;
+
+    void rewind()
+    {
+        cells = trace->getStartCells();
+        choice_points.clear();
+        position = 0;
+    }
+
+    void apply(quint32 step)
+    {
+        int index = traceIndex(step);
+        val value = traceValue(step);
+        switch(traceEvent(step)){
+        case TRACE_PLACE:{
+            cmask bit = cmask(cmask(1) << (value-1));
+            int row = index/TRACE::SIDE;
+            int col = index%TRACE::SIDE;
+            int box_r = (row/TRACE::BOX)*TRACE::BOX;
+            int box_c = (col/TRACE::BOX)*TRACE::BOX;
+            for(int i=0; i<TRACE::SIDE; i++){
+                cells[row*TRACE::SIDE+i].candidates &= ~bit;
+                cells[i*TRACE::SIDE+col].candidates &= ~bit;
+                cells[(box_r+i/TRACE::BOX)*TRACE::SIDE+box_c+i%TRACE::BOX].candidates &= ~bit;
+            }
+            cells[index].value = value;
+            cells[index].candidates = 0;
+            break;
+        }
+        case TRACE_ELIMINATE:
+            cells[index].candidates &= ~cmask(cmask(1) << (value-1));
+            break;
+        case TRACE_GUESS:
+            choice_points.push_back(cells);
+            break;
+        case TRACE_BACKTRACK:
+            if(!choice_points.isEmpty()){
+                cells = choice_points.last();
+                choice_points.pop_back();
+            }
+            break;
+        }
+    }
+};
+
+#endif // SUDOKUTRACE_H
@@ -0,0 +1,52 @@
+#ifndef SUDOKUTYPES_H
+#define SUDOKUTYPES_H
+
+#include "sudokugrid.h"
+#include <QtGlobal>
+#include <QtAlgorithms>
+#include <type_traits>
+
+// board geometry and cell values shared by all solver engines, see sudokugrid.h
+
+// mask with only the bit of value 'v' set
+inline cmask valueMask(val v){ return cmask(1u << (v-1)); }
+
+// number of candidates in the mask
+inline int candidateCount(cmask m){ return qPopulationCount(m); }
+inline int candidateCount(quint32 m){ return qPopulationCount(m); }
+
+// smallest candidate in the mask, the mask must not be empty
+// candidates are iterated as: for(cmask m = c; m; m &= m-1){ val v = firstCandidate(m); ... }
+inline val firstCandidate(cmask m){ return val(qCountTrailingZeroBits(m)+1); }
+inline val firstCandidate(quint32 m){ return val(qCountTrailingZeroBits(m)+1); }
+
+// candidate mask type of boards with BOX_SIZE x BOX_SIZE boxes, 16 bits up to 16x16, 32 bits for 25x25
+template<int BOX_SIZE>
+struct SudokuGeometry
+{
+    typedef typename std::conditional<BOX_SIZE*BOX_SIZE <= 16, quint16, quint32>::type MASK;
+};
+
+// text form of values: '1'-'9', then 'A' for 10 up to 'P' for 25; '0' and '.' are empty cells
+// returns 0 for an empty cell and -1 for an unknown character
+inline int valueFromChar(char c)
+{
+    if(c >= '1' && c <= '9'){
+        return c-'0';
+    }
+    if(c >= 'A' && c <= 'P'){
+        return c-'A'+10;
+    }
+    if(c >= 'a' && c <= 'p'){
+        return c-'a'+10;
+    }
+    return c == '0' || c == '.' ? 0 : -1;
+}
+
+// character of value 'v' (1..25), '.' for 0
+inline char charFromValue(val v)
+{
+    return v == 0 ? '.' : v <= 9 ? char('0'+v) : char('A'+v-10);
+}
+
+#endif // SUDOKUTYPES_H